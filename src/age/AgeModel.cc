@@ -67,6 +67,7 @@ AgeModel::AgeModel(std::shared_ptr<const Grid> grid,
     .units("s");
 
   m_ice_age.metadata()["valid_min"] = {0.0};
+  m_ice_age.enable_compression();
 
   m_work.metadata().units("s");
 }
@@ -45,6 +45,8 @@ static const char *isochrone_depth_variable_name = "isochrone_depth";
 static const char *times_parameter = "isochrones.deposition_times";
 static const char *N_max_parameter = "isochrones.max_n_layers";
 static const char *N_boot_parameter = "isochrones.bootstrapping.n_layers";
+static const char *block_size_parameter = "isochrones.block_size";
+static const char *merge_parameter = "isochrones.merge.max_thickness";
 
 
 //! Checks if a vector of doubles is not decreasing.
@@ -101,17 +103,18 @@ static std::shared_ptr<array::Array3D> allocate_layer_thickness(std::shared_ptr<
 }
 
 /*!
- * Allocate layer thicknesses and copy relevant info from `input`.
+ * Combine deposition times of layers read from an input file with requested deposition
+ * times.
+ *
+ * Keeps layers in `input` deposited before `T_start` and appends requested times after the
+ * last one of these.
  *
  * @param[in] input input layer thicknesses and deposition times, read from an input file
  * @param[in] T_start start time of the current run
  * @param[in] requested_times requested deposition times
  */
-static std::shared_ptr<array::Array3D>
-allocate_layer_thickness(const array::Array3D &input, double T_start,
-                         const std::vector<double> &requested_times) {
-
-  auto grid = input.grid();
+static std::vector<double> combine_deposition_times(const array::Array3D &input, double T_start,
+                                                    const std::vector<double> &requested_times) {
 
   const auto &input_times = input.levels();
 
@@ -129,7 +132,6 @@ allocate_layer_thickness(const array::Array3D &input, double T_start,
       deposition_times.push_back(t);
     }
   }
-  auto N_layers_to_copy = deposition_times.size();
 
   double last_kept_time = deposition_times.back();
   for (auto t : requested_times) {
@@ -138,22 +140,7 @@ allocate_layer_thickness(const array::Array3D &input, double T_start,
     }
   }
 
-  auto result = allocate_layer_thickness(grid, deposition_times);
-
-  array::AccessScope scope{ &input, result.get() };
-
-  for (Points p(*grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    const auto *in = input.get_column(i, j);
-    auto *out      = result->get_column(i, j);
-
-    for (size_t k = 0; k < N_layers_to_copy; ++k) {
-      out[k] = in[k];
-    }
-  }
-
-  return result;
+  return deposition_times;
 }
 
 /*!
@@ -366,9 +353,189 @@ Isochrones::Isochrones(std::shared_ptr<const Grid> grid,
   // Note: array::Array delays allocation until the last moment, so we can cheaply
   // re-allocate storage if the number of "levels" used here turns out to be
   // inappropriate.
-  m_layer_thickness = details::allocate_layer_thickness(m_grid, { time->current() });
+  set_deposition_times({ time->current() });
+  m_top_layer_index = details::n_active_layers(m_deposition_times, time->start()) - 1;
+  allocate_storage(1);
+}
+
+/*!
+ * Set deposition times of all layers (including ones that are not active yet).
+ *
+ * Isochrones reported in output files correspond to these times.
+ */
+void Isochrones::set_deposition_times(const std::vector<double> &times) {
+  using namespace details;
+
+  auto N_max = (int)m_config->get_number(N_max_parameter);
+  if ((int)times.size() > N_max) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "the total number of isochronal layers (%d) exceeds '%s' = %d",
+                                  (int)times.size(), N_max_parameter, (int)N_max);
+  }
+
+  m_deposition_times = times;
+  m_isochrone_times  = times;
+
+  m_isochrone_index.resize(times.size());
+  for (size_t k = 0; k < times.size(); ++k) {
+    m_isochrone_index[k] = k;
+  }
+
+  m_layer_thickness.reset();
+}
+
+/*!
+ * Make sure that the storage for layer thicknesses can hold at least `n_layers` layers.
+ *
+ * Storage is allocated in blocks of `isochrones.block_size` layers. Thicknesses of layers
+ * that are already stored are preserved, new layers have zero thickness.
+ *
+ * Also re-allocates (and shrinks) storage if deposition times of stored layers changed,
+ * i.e. after merging layers.
+ */
+void Isochrones::allocate_storage(size_t n_layers) {
+  using namespace details;
+
+  auto block_size = (int)m_config->get_number(block_size_parameter);
+  if (block_size < 1) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "%s has to be positive (got %d)",
+                                  block_size_parameter, block_size);
+  }
+
+  size_t B = block_size;
+  size_t N = std::min(((n_layers + B - 1) / B) * B, m_deposition_times.size());
+
+  std::vector<double> times(m_deposition_times.begin(), m_deposition_times.begin() + N);
+
+  if (m_layer_thickness and m_layer_thickness->levels() == times) {
+    // nothing to do
+    return;
+  }
+
+  auto result = allocate_layer_thickness(m_grid, times);
+  result->set(0.0);
+
+  if (m_layer_thickness) {
+    size_t N_copy = std::min(N, m_layer_thickness->levels().size());
+
+    array::AccessScope scope{ m_layer_thickness.get(), result.get() };
+
+    for (auto p = m_grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      const double *in = m_layer_thickness->get_column(i, j);
+      double *out      = result->get_column(i, j);
+
+      for (size_t k = 0; k < N_copy; ++k) {
+        out[k] = in[k];
+      }
+    }
+  }
+
+  m_layer_thickness = result;
   m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
-  m_top_layer_index = details::n_active_layers(m_layer_thickness->levels(), time->start()) - 1;
+}
+
+/*!
+ * Merge thin adjacent layers below the top layer.
+ *
+ * Adjacent layers are merged if their combined thickness does not exceed
+ * `isochrones.merge.max_thickness` anywhere in the domain. An isochrone removed by merging
+ * is between the bottom and the top of the merged layer, so it is within this distance of
+ * a retained isochrone. The merged layer keeps the earliest deposition time.
+ *
+ * We use the sum of maximum thicknesses of merged layers as an upper bound of their
+ * combined thickness; this requires only one reduction.
+ */
+void Isochrones::merge_thin_layers() {
+  using namespace details;
+
+  double max_thickness = m_config->get_number(merge_parameter);
+
+  // the top layer is never merged, so we need at least two layers below it
+  if (not (max_thickness > 0.0) or m_top_layer_index < 2) {
+    return;
+  }
+
+  size_t N = m_top_layer_index;
+
+  // maximum thicknesses of layers below the top layer
+  std::vector<double> H_max(N, 0.0);
+  {
+    std::vector<double> H_max_local(N, 0.0);
+
+    array::AccessScope scope{ m_layer_thickness.get() };
+
+    for (auto p = m_grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      const double *H = m_layer_thickness->get_column(i, j);
+      for (size_t k = 0; k < N; ++k) {
+        H_max_local[k] = std::max(H_max_local[k], H[k]);
+      }
+    }
+
+    GlobalMax(m_grid->com, H_max_local.data(), H_max.data(), (int)N);
+  }
+
+  // merged[k] is true if the layer k is merged into the layer below it
+  std::vector<bool> merged(N, false);
+  size_t n_merged = 0;
+  {
+    double H = H_max[0];
+    for (size_t k = 1; k < N; ++k) {
+      if (H + H_max[k] <= max_thickness) {
+        merged[k] = true;
+        n_merged += 1;
+        H += H_max[k];
+      } else {
+        H = H_max[k];
+      }
+    }
+  }
+
+  if (n_merged == 0) {
+    return;
+  }
+
+  {
+    array::AccessScope scope{ m_layer_thickness.get() };
+
+    for (auto p = m_grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      double *H = m_layer_thickness->get_column(i, j);
+
+      size_t n = 0;
+      for (size_t k = 1; k <= m_top_layer_index; ++k) {
+        if (k < N and merged[k]) {
+          H[n] += H[k];
+        } else {
+          n += 1;
+          H[n] = H[k];
+        }
+      }
+
+      // layers above the new top layer are not active
+      for (size_t k = n + 1; k <= m_top_layer_index; ++k) {
+        H[k] = 0.0;
+      }
+    }
+  }
+
+  for (int k = (int)N - 1; k > 0; --k) {
+    if (merged[k]) {
+      m_deposition_times.erase(m_deposition_times.begin() + k);
+      m_isochrone_index.erase(m_isochrone_index.begin() + k);
+    }
+  }
+  m_top_layer_index -= n_merged;
+
+  m_log->message(2, "  Merged %d thin isochronal layers (%d layers remain)\n", (int)n_merged,
+                 (int)m_top_layer_index + 1);
+
+  // re-allocate to update deposition times of stored layers and release storage
+  allocate_storage(m_top_layer_index + 1);
 }
 
 /*!
@@ -430,9 +597,9 @@ void Isochrones::bootstrap(const array::Scalar &ice_thickness) {
         deposition_times.push_back(t);
       }
 
-      // re-allocate storage
-      m_layer_thickness = allocate_layer_thickness(m_grid, deposition_times);
-      m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
+      set_deposition_times(deposition_times);
+      m_top_layer_index = n_active_layers(m_deposition_times, time->start()) - 1;
+      allocate_storage(m_top_layer_index + 1);
 
       array::AccessScope scope{ &ice_thickness, m_layer_thickness.get() };
 
@@ -448,8 +615,9 @@ void Isochrones::bootstrap(const array::Scalar &ice_thickness) {
       }
     } else {
 
-      m_layer_thickness = allocate_layer_thickness(m_grid, requested_times);
-      m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
+      set_deposition_times(requested_times);
+      m_top_layer_index = n_active_layers(m_deposition_times, time->start()) - 1;
+      allocate_storage(std::max(m_top_layer_index + 1, (size_t)1));
 
       array::AccessScope scope{ &ice_thickness, m_layer_thickness.get() };
 
@@ -459,10 +627,9 @@ void Isochrones::bootstrap(const array::Scalar &ice_thickness) {
       }
     }
 
-    m_top_layer_index = n_active_layers(m_layer_thickness->levels(), time->start()) - 1;
     {
       std::vector<std::string> dates;
-      for (auto t : m_layer_thickness->levels()) {
+      for (auto t : m_deposition_times) {
         dates.push_back(time->date(t));
       }
       m_log->message(3, "Deposition times: %s\n", join(dates, ", ").c_str());
@@ -493,25 +660,42 @@ void Isochrones::initialize(const File &input_file, int record, bool use_interpo
     const auto &time = m_grid->ctx()->time();
 
     {
-      std::shared_ptr<array::Array3D> tmp;
+      std::shared_ptr<array::Array3D> input;
 
       if (use_interpolation) {
-        tmp = regrid_layer_thickness(m_grid, input_file, record);
+        input = regrid_layer_thickness(m_grid, input_file, record);
       } else {
-        tmp = read_layer_thickness(m_grid, input_file, record);
+        input = read_layer_thickness(m_grid, input_file, record);
       }
 
-      m_layer_thickness =
-          allocate_layer_thickness(*tmp, time->start(), deposition_times(*m_config, *time));
-    }
-    m_tmp = m_layer_thickness->duplicate(array::WITH_GHOSTS);
+      set_deposition_times(
+          combine_deposition_times(*input, time->start(), deposition_times(*m_config, *time)));
+
+      // set m_top_layer_index
+      m_top_layer_index = n_active_layers(m_deposition_times, time->start()) - 1;
+
+      allocate_storage(m_top_layer_index + 1);
 
-    // set m_top_layer_index
-    m_top_layer_index = n_active_layers(m_layer_thickness->levels(), time->start()) - 1;
+      // copy thicknesses of layers deposited before the start of this run
+      auto N_layers_to_copy = n_active_layers(input->levels(), time->start());
+
+      array::AccessScope scope{ input.get(), m_layer_thickness.get() };
+
+      for (auto p = m_grid->points(); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        const auto *in = input->get_column(i, j);
+        auto *out      = m_layer_thickness->get_column(i, j);
+
+        for (size_t k = 0; k < N_layers_to_copy; ++k) {
+          out[k] = in[k];
+        }
+      }
+    }
 
     {
       std::vector<std::string> dates;
-      for (auto t : m_layer_thickness->levels()) {
+      for (auto t : m_deposition_times) {
         dates.push_back(time->date(t));
       }
       m_log->message(3, "Deposition times: %s\n", join(dates, ", ").c_str());
@@ -694,7 +878,7 @@ void Isochrones::update(double t, double dt, const array::Array3D &u, const arra
   // add one more layer if we reached the next deposition time
   {
     double T                     = t + dt;
-    const auto &deposition_times = m_layer_thickness->levels();
+    const auto &deposition_times = m_deposition_times;
     size_t N                     = deposition_times.size();
 
     // Find the index k such that deposition_times[k] <= T
@@ -718,6 +902,10 @@ void Isochrones::update(double t, double dt, const array::Array3D &u, const arra
         const auto &time = m_grid->ctx()->time();
         m_log->message(2, "  New isochronal layer %d at %s\n", (int)m_top_layer_index,
                        time->date(T).c_str());
+
+        allocate_storage(m_top_layer_index + 1);
+
+        merge_thin_layers();
       } else {
         // we have as many layers as we can handle: keep adding to the top layer
         m_log->message(2,
@@ -749,7 +937,7 @@ MaxTimestep Isochrones::max_timestep_cfl() const {
  * We can go up to the next deposition time.
  */
 MaxTimestep Isochrones::max_timestep_deposition_times(double t) const {
-  auto deposition_times = m_layer_thickness->levels();
+  const auto &deposition_times = m_deposition_times;
 
   double t0 = deposition_times[0];
   if (t < t0) {
@@ -776,21 +964,67 @@ MaxTimestep Isochrones::max_timestep_deposition_times(double t) const {
 /*!
  * Define the model state in an output file.
  *
- * We are saving layer thicknesses, deposition times, and the number of active layers.
+ * We are saving layer thicknesses and deposition times of all isochrones (see
+ * `layer_thicknesses()`).
  */
 void Isochrones::define_model_state_impl(const File &output) const {
-  m_layer_thickness->define(output, io::PISM_DOUBLE);
+  details::allocate_layer_thickness(m_grid, m_isochrone_times)->define(output, io::PISM_DOUBLE);
 }
 
 /*!
  * Write the model state to an output file.
  */
 void Isochrones::write_model_state_impl(const File &output) const {
-  m_layer_thickness->write(output);
+  auto result = details::allocate_layer_thickness(m_grid, m_isochrone_times);
+
+  layer_thicknesses(*result);
+
+  result->write(output);
 }
 
-const array::Array3D &Isochrones::layer_thicknesses() const {
-  return *m_layer_thickness;
+/*!
+ * Deposition times of isochrones reported in output files.
+ *
+ * Includes layers that are not active yet and isochrones removed by merging layers.
+ *
+ * Output files use one level per deposition time (instead of one level per stored layer)
+ * because snapshot and "extra" files append records and need a dimension of fixed length.
+ */
+const std::vector<double> &Isochrones::deposition_times() const {
+  return m_isochrone_times;
+}
+
+/*!
+ * Copy layer thicknesses to `result`, which has to use `deposition_times()` as levels.
+ *
+ * Layers that are not active yet and layers removed by merging have zero thickness, so an
+ * isochrone removed by merging is reported at the top of the layer containing it.
+ */
+void Isochrones::layer_thicknesses(array::Array3D &result) const {
+  size_t N = result.levels().size();
+
+  if (N != m_isochrone_times.size()) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "'%s' has %d levels (expected %d)", result.get_name().c_str(),
+                                  (int)N, (int)m_isochrone_times.size());
+  }
+
+  array::AccessScope scope{ m_layer_thickness.get(), &result };
+
+  for (auto p = m_grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    const double *d = m_layer_thickness->get_column(i, j);
+    double *column  = result.get_column(i, j);
+
+    for (size_t k = 0; k < N; ++k) {
+      column[k] = 0.0;
+    }
+
+    for (size_t k = 0; k <= m_top_layer_index; ++k) {
+      column[m_isochrone_index[k]] = d[k];
+    }
+  }
 }
 
 namespace diagnostics {
@@ -803,7 +1037,7 @@ public:
 
     const auto &time = m_grid->ctx()->time();
 
-    m_vars = { { m_sys, isochrone_depth_variable_name, model->layer_thicknesses().levels() } };
+    m_vars = { { m_sys, isochrone_depth_variable_name, model->deposition_times() } };
 
     auto description = pism::printf("depth below surface of isochrones for times in '%s'",
                                     deposition_time_variable_name);
@@ -821,24 +1055,23 @@ public:
 protected:
   std::shared_ptr<array::Array> compute_impl() const {
 
-    const auto &layer_thicknesses = model->layer_thicknesses();
+    auto result = details::allocate_layer_thickness(m_grid, model->deposition_times());
 
-    auto result         = layer_thicknesses.duplicate();
+    model->layer_thicknesses(*result);
     result->metadata(0) = m_vars[0];
 
     size_t N = result->levels().size();
 
-    array::AccessScope scope{ &layer_thicknesses, result.get() };
+    array::AccessScope scope{ result.get() };
 
     for (auto p = m_grid->points(); p; p.next()) {
       const int i = p.i(), j = p.j();
 
-      double *column  = result->get_column(i, j);
-      const double *d = layer_thicknesses.get_column(i, j);
+      double *column = result->get_column(i, j);
 
       double total_depth = 0.0;
       for (int k = (int)N - 1; k >= 0; --k) {
-        total_depth += d[k];
+        total_depth += column[k];
         column[k] = total_depth;
       }
     }
@@ -847,12 +1080,31 @@ protected:
   }
 };
 
+/*! @brief Report isochronal layer thicknesses, in meters */
+class LayerThicknesses : public Diag<Isochrones> {
+public:
+  LayerThicknesses(const Isochrones *m) : Diag<Isochrones>(m) {
+    m_vars = { details::allocate_layer_thickness(m_grid, model->deposition_times())->metadata(0) };
+  }
+
+protected:
+  std::shared_ptr<array::Array> compute_impl() const {
+
+    auto result = details::allocate_layer_thickness(m_grid, model->deposition_times());
+
+    model->layer_thicknesses(*result);
+
+    return result;
+  }
+};
+
 } // end of namespace diagnostics
 
 DiagnosticList Isochrones::diagnostics_impl() const {
   return { { details::isochrone_depth_variable_name,
              Diagnostic::Ptr(new diagnostics::IsochroneDepths(this)) },
-           { details::layer_thickness_variable_name, Diagnostic::wrap(*m_layer_thickness) } };
+           { details::layer_thickness_variable_name,
+             Diagnostic::Ptr(new diagnostics::LayerThicknesses(this)) } };
 }
 
 } // end of namespace pism
@@ -52,7 +52,9 @@ public:
               const array::Scalar &top_surface_mass_balance,
               const array::Scalar &bottom_surface_mass_balance);
 
-  const array::Array3D& layer_thicknesses() const;
+  const std::vector<double> &deposition_times() const;
+
+  void layer_thicknesses(array::Array3D &result) const;
 
 private:
   MaxTimestep max_timestep_impl(double t) const;
@@ -69,9 +71,26 @@ private:
 
   void initialize(const File &input_file, int record, bool use_interpolation);
 
-  //! isochronal layer thicknesses
+  void set_deposition_times(const std::vector<double> &times);
+  void allocate_storage(size_t n_layers);
+  void merge_thin_layers();
+
+  //! isochronal layer thicknesses (only layers that are active or will become active
+  //! soon are stored)
   std::shared_ptr<array::Array3D> m_layer_thickness;
 
+  //! deposition times of stored layers followed by deposition times of layers that are
+  //! not active yet
+  std::vector<double> m_deposition_times;
+
+  //! deposition times of all isochrones used in output files (includes isochrones removed
+  //! by merging layers)
+  std::vector<double> m_isochrone_times;
+
+  //! `m_isochrone_index[k]` is the index of the deposition time of the layer `k` in
+  //! `m_isochrone_times`
+  std::vector<size_t> m_isochrone_index;
+
   //! temporary storage needed for time stepping
   std::shared_ptr<array::Array3D> m_tmp;
 
@@ -17,7 +17,9 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <gsl/gsl_poly.h>
+#include <algorithm>            // std::min
 #include <cassert>
+#include <cmath>                // std::sqrt
 
 #include "pism/coupler/ocean/GivenTH.hh"
 #include "pism/coupler/util/options.hh"
@@ -57,6 +59,8 @@ GivenTH::Constants::Constants(const Config &config) {
   limit_salinity_range             = config.get_flag("ocean.th.clip_salinity");
 }
 
+const int GivenTH::batch_size;
+
 GivenTH::GivenTH(std::shared_ptr<const Grid> g)
   : CompleteOceanModel(g, std::shared_ptr<OceanModel>()) {
 
@@ -153,25 +157,43 @@ void GivenTH::update_impl(const Geometry &geometry, double t, double dt) {
   array::AccessScope list{ &ice_thickness, m_theta_ocean.get(), m_salinity_ocean.get(),
       &temperature, &mass_flux};
 
-  for (auto p = m_grid->points(); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    double potential_temperature_celsius = (*m_theta_ocean)(i,j) - 273.15;
-
-    double
-      shelf_base_temp_celsius = 0.0,
-      shelf_base_massflux     = 0.0;
-
-    pointwise_update(c,
-                     (*m_salinity_ocean)(i,j),
-                     potential_temperature_celsius,
-                     ice_thickness(i,j),
-                     &shelf_base_temp_celsius,
-                     &shelf_base_massflux);
-
-    // Convert from Celsius to Kelvin:
-    temperature(i,j) = shelf_base_temp_celsius + 273.15;
-    mass_flux(i,j)   = shelf_base_massflux;
+  // Process each grid row in batches of up to batch_size cells.
+  double
+    salinity[batch_size],
+    theta[batch_size],
+    thickness[batch_size],
+    shelf_base_temp_celsius[batch_size],
+    shelf_base_massflux[batch_size];
+
+  const int
+    xs = m_grid->xs(),
+    xm = m_grid->xm(),
+    ys = m_grid->ys(),
+    ym = m_grid->ym();
+
+  for (int j = ys; j < ys + ym; ++j) {
+    for (int i0 = xs; i0 < xs + xm; i0 += batch_size) {
+      const int n = std::min(batch_size, xs + xm - i0);
+
+      for (int k = 0; k < n; ++k) {
+        const int i = i0 + k;
+
+        salinity[k]  = (*m_salinity_ocean)(i, j);
+        theta[k]     = (*m_theta_ocean)(i, j) - 273.15;
+        thickness[k] = ice_thickness(i, j);
+      }
+
+      batch_update(c, n, salinity, theta, thickness,
+                   shelf_base_temp_celsius, shelf_base_massflux);
+
+      for (int k = 0; k < n; ++k) {
+        const int i = i0 + k;
+
+        // Convert from Celsius to Kelvin:
+        temperature(i, j) = shelf_base_temp_celsius[k] + 273.15;
+        mass_flux(i, j)   = shelf_base_massflux[k];
+      }
+    }
   }
 
   // convert mass flux from [m s-1] to [kg m-2 s-1]:
@@ -219,6 +241,8 @@ static double shelf_base_melt_rate(GivenTH::Constants c,
  *
  * See the manual for details.
  *
+ * This is the reference implementation; GivenTH::update_impl() uses batch_update().
+ *
  * @param[in] constants model constants
  * @param[in] sea_water_salinity sea water salinity
  * @param[in] sea_water_potential_temperature sea water potential temperature
@@ -519,5 +543,171 @@ void GivenTH::subshelf_salinity_diffusion_only(const Constants &c,
   *shelf_base_salinity = S2;
 }
 
+/*!
+ * Larger root of the quadratic equation `a*x^2 + b*x + c = 0` (zero if there are no real
+ * roots).
+ *
+ * Uses the same formulas as `gsl_poly_solve_quadratic()`, but selects the result instead
+ * of branching so that loops calling this function can be vectorized.
+ */
+static inline double larger_root(double a, double b, double c) {
+  const double
+    disc = b * b - 4 * a * c,
+    sgnb = (b > 0 ? 1.0 : -1.0),
+    temp = -0.5 * (b + sgnb * std::sqrt(std::max(disc, 0.0))),
+    // all formulas below are evaluated: avoid dividing by zero in ones that are not used
+    // (temp is zero only if disc == 0 and b == 0)
+    a_   = (a != 0.0 ? a : 1.0),
+    t_   = (temp != 0.0 ? temp : 1.0),
+    r1   = temp / a_,
+    r2   = c / t_,
+    r    = std::sqrt(std::max(-c / a_, 0.0)), // used if b == 0
+    r0   = -0.5 * b / a_;                     // used if disc == 0
+
+  double result = 0.0;
+  result = (disc == 0.0) ? r0 : result;
+  result = (disc > 0.0) ? (b == 0.0 ? r : (r1 < r2 ? r2 : r1)) : result;
+
+  return a == 0.0 ? 0.0 : result;
+}
+
+/** @brief Compute temperature and melt rate at the base of the shelf at `n` grid cells.
+ *
+ * This is equivalent to calling pointwise_update() for each cell. Input and output arrays
+ * are stored contiguously and have at least `n` elements; `n` has to be at most
+ * `batch_size`.
+ *
+ * Basal salinities corresponding to all three cases (melt, freeze-on and diffusion-only)
+ * are computed at all cells and the first consistent one is selected using masks, so that
+ * the compiler can vectorize loops below. The diffusion-only case is skipped if it is
+ * not needed in the whole batch.
+ *
+ * Because of this, divisors in formulas for cases that do not apply at a given cell are
+ * replaced by non-zero values before dividing. This keeps the code safe to run with
+ * floating point exceptions trapped (`-fp_trap`).
+ *
+ * The diffusion-only case is not defined at ice-free cells (pointwise_update() divides by
+ * zero). Ice-free cells needing it get the basal salinity corresponding to the thickness of
+ * 1 meter. The melt rate is zero at these cells in any case.
+ *
+ * @param[in] c model constants
+ * @param[in] n number of cells
+ * @param[in] sea_water_salinity sea water salinity
+ * @param[in] sea_water_potential_temperature sea water potential temperature
+ * @param[in] thickness ice shelf thickness
+ * @param[out] shelf_base_temperature_out resulting basal temperature
+ * @param[out] shelf_base_melt_rate_out resulting basal melt rate
+ */
+void GivenTH::batch_update(const Constants &c,
+                           int n,
+                           const double *sea_water_salinity,
+                           const double *sea_water_potential_temperature,
+                           const double *thickness,
+                           double *shelf_base_temperature_out,
+                           double *shelf_base_melt_rate_out) {
+  assert(n <= batch_size);
+
+  const double
+    min_salinity = 4.0,
+    max_salinity = 40.0,
+    c_pI         = c.ice_specific_heat_capacity,
+    c_pW         = c.sea_water_specific_heat_capacity,
+    L            = c.water_latent_heat_fusion,
+    T_S          = c.shelf_top_surface_temperature,
+    rho_W        = c.sea_water_density,
+    rho_I        = c.ice_density,
+    kappa        = c.ice_thermal_diffusivity;
+
+  const bool clip = c.limit_salinity_range;
+
+  // quadratic equation coefficients that do not depend on inputs
+  const double
+    A_melt      = c.a[0] * c.gamma_S * c_pI - c.b[0] * c.gamma_T * c_pW,
+    A_freeze_on = -c.b[0] * c.gamma_T * c_pW;
+
+  // sea water salinity, basal salinity and the flag marking cells that need the
+  // diffusion-only case (one or zero; stored as a double to help vectorization)
+  double
+    S_W[batch_size],
+    S_b[batch_size],
+    use_diffusion_only[batch_size];
+
+  // Melt and freeze-on cases
+  double n_diffusion_only = 0.0;
+  for (int k = 0; k < n; ++k) {
+    const double
+      S       = sea_water_salinity[k],
+      Theta_W = sea_water_potential_temperature[k],
+      h       = thickness[k];
+
+    assert(h >= 0.0);
+
+    // This model works for sea water salinity in the range of [4, 40] psu.
+    S_W[k] = clip ? (S < min_salinity ? min_salinity : (S > max_salinity ? max_salinity : S)) : S;
+
+    const double
+      B_melt = (c.gamma_S * (L - c_pI * (T_S + c.a[0] * S_W[k] - c.a[2] * h - c.a[1])) +
+                c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1])),
+      C_melt = -c.gamma_S * S_W[k] * (L - c_pI * (T_S - c.a[2] * h - c.a[1])),
+      B_freeze_on = c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]),
+      C_freeze_on = -c.gamma_S * S_W[k] * L;
+
+    const double
+      S_melt = larger_root(A_melt, B_melt, C_melt),
+      S_fo   = larger_root(A_freeze_on, B_freeze_on, C_freeze_on);
+
+    // larger_root() returns zero if there are no real roots; pointwise_update() requires
+    // positive basal salinities, so cases with zero roots are treated as inconsistent
+    const double
+      M_melt = shelf_base_melt_rate(c, S_W[k], S_melt > 0.0 ? S_melt : 1.0),
+      M_fo   = shelf_base_melt_rate(c, S_W[k], S_fo > 0.0 ? S_fo : 1.0);
+
+    const bool
+      melt      = S_melt > 0.0 and M_melt > 0.0,
+      freeze_on = S_fo > 0.0 and M_fo < 0.0;
+
+    S_b[k]                = melt ? S_melt : S_fo;
+    use_diffusion_only[k] = (melt or freeze_on) ? 0.0 : 1.0;
+    n_diffusion_only += use_diffusion_only[k];
+  }
+
+  // Diffusion-only case (rarely needed)
+  if (n_diffusion_only > 0.0) {
+    for (int k = 0; k < n; ++k) {
+      // avoid dividing by zero at ice-free cells (see above)
+      const double
+        Theta_W = sea_water_potential_temperature[k],
+        h       = thickness[k] > 0.0 ? thickness[k] : 1.0;
+
+      const double
+        A = -(c.b[0] * c.gamma_T * h * rho_W * c_pW - c.a[0] * rho_I * c_pI * kappa) / (h * rho_W),
+        B = ((rho_I * c_pI * kappa * (T_S - c.a[2] * h - c.a[1])) / (h * rho_W) +
+             c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1])),
+        C = -c.gamma_S * S_W[k] * L;
+
+      const double S = larger_root(A, B, C);
+
+      S_b[k] = use_diffusion_only[k] > 0.0 ? S : S_b[k];
+    }
+  }
+
+  // Shelf base temperature and melt rate
+  for (int k = 0; k < n; ++k) {
+    const double h = thickness[k];
+
+    // Clip basal salinity so that we can use the freezing point
+    // temperature parameterization to recover shelf base temperature.
+    double S = S_b[k];
+    S = clip ? (S <= min_salinity ? min_salinity : (S >= max_salinity ? max_salinity : S)) : S;
+
+    const double M = shelf_base_melt_rate(c, S_W[k], S);
+
+    shelf_base_temperature_out[k] = melting_point_temperature(c, S, h);
+
+    // no melt if there is no ice
+    shelf_base_melt_rate_out[k] = h == 0.0 ? 0.0 : M;
+  }
+}
+
 } // end of namespace ocean
 } // end of namespace pism
@@ -57,6 +57,24 @@ public:
     double ice_thermal_diffusivity;
     bool limit_salinity_range;
   };
+
+  static void pointwise_update(const Constants &constants,
+                               double sea_water_salinity,
+                               double sea_water_potential_temperature,
+                               double ice_thickness,
+                               double *shelf_base_temperature_out,
+                               double *shelf_base_melt_rate_out);
+
+  //! Maximum number of grid cells processed by one call of batch_update().
+  static const int batch_size = 64;
+
+  static void batch_update(const Constants &constants,
+                           int n,
+                           const double *sea_water_salinity,
+                           const double *sea_water_potential_temperature,
+                           const double *ice_thickness,
+                           double *shelf_base_temperature_out,
+                           double *shelf_base_melt_rate_out);
 private:
   void update_impl(const Geometry &geometry, double t, double dt);
   void init_impl(const Geometry &geometry);
@@ -65,36 +83,29 @@ private:
   std::shared_ptr<array::Forcing> m_theta_ocean;
   std::shared_ptr<array::Forcing> m_salinity_ocean;
 
-  void pointwise_update(const Constants &constants,
-                        double sea_water_salinity,
-                        double sea_water_potential_temperature,
-                        double ice_thickness,
-                        double *shelf_base_temperature_out,
-                        double *shelf_base_melt_rate_out);
-
-  void subshelf_salinity(const Constants &constants,
-                         double sea_water_salinity,
-                         double sea_water_potential_temperature,
-                         double ice_thickness,
-                         double *shelf_base_salinity);
-
-  void subshelf_salinity_melt(const Constants &constants,
-                              double sea_water_salinity,
-                              double sea_water_potential_temperature,
-                              double ice_thickness,
-                              double *shelf_base_salinity);
-
-  void subshelf_salinity_freeze_on(const Constants &constants,
-                                   double sea_water_salinity,
-                                   double sea_water_potential_temperature,
-                                   double ice_thickness,
-                                   double *shelf_base_salinity);
-
-  void subshelf_salinity_diffusion_only(const Constants &constants,
-                                        double sea_water_salinity,
-                                        double sea_water_potential_temperature,
-                                        double ice_thickness,
-                                        double *shelf_base_salinity);
+  static void subshelf_salinity(const Constants &constants,
+                                double sea_water_salinity,
+                                double sea_water_potential_temperature,
+                                double ice_thickness,
+                                double *shelf_base_salinity);
+
+  static void subshelf_salinity_melt(const Constants &constants,
+                                     double sea_water_salinity,
+                                     double sea_water_potential_temperature,
+                                     double ice_thickness,
+                                     double *shelf_base_salinity);
+
+  static void subshelf_salinity_freeze_on(const Constants &constants,
+                                          double sea_water_salinity,
+                                          double sea_water_potential_temperature,
+                                          double ice_thickness,
+                                          double *shelf_base_salinity);
+
+  static void subshelf_salinity_diffusion_only(const Constants &constants,
+                                               double sea_water_salinity,
+                                               double sea_water_potential_temperature,
+                                               double ice_thickness,
+                                               double *shelf_base_salinity);
 };
 
 } // end of namespace ocean
@@ -318,11 +318,13 @@ void Pico::update_impl(const Geometry &geometry, double t, double dt) {
                     m_Toc,
                     m_Soc);
 
+    // Collect cells in each box and compute box areas (one pass over the grid)
+    index_boxes(m_geometry.ice_shelf_mask(), m_geometry.box_mask(), m_boxes);
+
     // In ice shelves, replace Beckmann-Goosse values using the Olbers and Hellmer model.
     process_box1(physics,
+                 m_boxes,                                   // input
                  ice_thickness,                             // input
-                 m_geometry.ice_shelf_mask(),               // input
-                 m_geometry.box_mask(),                     // input
                  m_Toc_box0,                                // input
                  m_Soc_box0,                                // input
                  m_basal_melt_rate,
@@ -333,9 +335,8 @@ void Pico::update_impl(const Geometry &geometry, double t, double dt) {
                  m_overturning);
 
     process_other_boxes(physics,
+                        m_boxes,                     // input
                         ice_thickness,               // input
-                        m_geometry.ice_shelf_mask(), // input
-                        m_geometry.box_mask(),       // input
                         m_basal_melt_rate,
                         *m_shelf_base_temperature,
                         m_T_star,
@@ -626,9 +627,8 @@ void Pico::beckmann_goosse(const PicoPhysics &physics,
 
 
 void Pico::process_box1(const PicoPhysics &physics,
+                        const Boxes &boxes,
                         const array::Scalar &ice_thickness,
-                        const array::Scalar &shelf_mask,
-                        const array::Scalar &box_mask,
                         const array::Scalar &Toc_box0,
                         const array::Scalar &Soc_box0,
                         array::Scalar &basal_melt_rate,
@@ -638,23 +638,19 @@ void Pico::process_box1(const PicoPhysics &physics,
                         array::Scalar &Soc,
                         array::Scalar &overturning) {
 
-  std::vector<double> box1_area(m_n_shelves);
-
-  compute_box_area(1, shelf_mask, box_mask, box1_area);
+  const double *box1_area = &boxes.area[1 * m_n_shelves];
 
-  array::AccessScope list{ &ice_thickness, &shelf_mask, &box_mask,    &T_star,          &Toc_box0,          &Toc,
-                                &Soc_box0,      &Soc,        &overturning, &basal_melt_rate, &basal_temperature };
+  array::AccessScope list{ &ice_thickness, &T_star,          &Toc_box0,         &Toc, &Soc_box0,
+                           &Soc,           &overturning,     &basal_melt_rate, &basal_temperature };
 
   int n_Toc_failures = 0;
 
   // basal melt rate, ambient temperature and salinity and overturning calculation
   // for each box1 grid cell.
-  for (auto p = m_grid->points(); p; p.next()) {
-    const int i = p.i(), j = p.j();
+  for (const auto &cell : boxes.cells[1]) {
+    const int i = cell.i, j = cell.j, shelf_id = cell.shelf_id;
 
-    int shelf_id = shelf_mask.as_int(i, j);
-
-    if (box_mask.as_int(i, j) == 1 and shelf_id > 0) {
+    if (shelf_id > 0) {
 
       const double pressure = physics.pressure(ice_thickness(i, j));
 
@@ -695,32 +691,36 @@ void Pico::process_box1(const PicoPhysics &physics,
 }
 
 void Pico::process_other_boxes(const PicoPhysics &physics,
+                               const Boxes &boxes,
                                const array::Scalar &ice_thickness,
-                               const array::Scalar &shelf_mask,
-                               const array::Scalar &box_mask,
                                array::Scalar &basal_melt_rate,
                                array::Scalar &basal_temperature,
                                array::Scalar &T_star,
                                array::Scalar &Toc,
                                array::Scalar &Soc) const {
 
-  std::vector<double> overturning(m_n_shelves, 0.0);
-  std::vector<double> salinity(m_n_shelves, 0.0);
-  std::vector<double> temperature(m_n_shelves, 0.0);
+  std::vector<std::vector<double> > averages;
 
-  // get average overturning from box 1 that is used as input later
-  compute_box_average(1, m_overturning, shelf_mask, box_mask, overturning);
+  // average overturning from box 1 that is used as input later
+  std::vector<double> overturning(m_n_shelves, 0.0);
 
   std::vector<bool> use_beckmann_goosse(m_n_shelves);
 
-  array::AccessScope list{ &ice_thickness, &shelf_mask,      &box_mask,           &T_star,   &Toc,
-                                &Soc,           &basal_melt_rate, &basal_temperature };
+  array::AccessScope list{ &ice_thickness, &T_star, &Toc, &Soc, &basal_melt_rate, &basal_temperature };
 
   // Iterate over all boxes i for i > 1
   for (int box = 2; box <= m_n_boxes; ++box) {
 
-    compute_box_average(box - 1, Toc, shelf_mask, box_mask, temperature);
-    compute_box_average(box - 1, Soc, shelf_mask, box_mask, salinity);
+    // get inputs from the previous box (and the box 1 overturning, which uses the same
+    // reduction)
+    if (box == 2) {
+      compute_box_averages(boxes, box - 1, { &Toc, &Soc, &m_overturning }, averages);
+      overturning = averages[2];
+    } else {
+      compute_box_averages(boxes, box - 1, { &Toc, &Soc }, averages);
+    }
+    const std::vector<double> &temperature = averages[0];
+    const std::vector<double> &salinity    = averages[1];
 
     // find all the shelves where we should fall back to the Beckmann-Goosse
     // parameterization
@@ -730,17 +730,14 @@ void Pico::process_other_boxes(const PicoPhysics &physics,
                                 overturning[s] == 0.0);
     }
 
-    std::vector<double> box_area;
-    compute_box_area(box, shelf_mask, box_mask, box_area);
+    const double *box_area = &boxes.area[box * m_n_shelves];
 
     int n_beckmann_goosse_cells = 0;
 
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      int shelf_id = shelf_mask.as_int(i, j);
+    for (const auto &cell : boxes.cells[box]) {
+      const int i = cell.i, j = cell.j, shelf_id = cell.shelf_id;
 
-      if (box_mask.as_int(i, j) == box and shelf_id > 0) {
+      if (shelf_id > 0) {
 
         if (use_beckmann_goosse[shelf_id]) {
           n_beckmann_goosse_cells += 1;
@@ -766,7 +763,7 @@ void Pico::process_other_boxes(const PicoPhysics &physics,
           basal_temperature(i, j) = physics.T_pm(Soc(i, j), pressure);
         }
       }
-    } // loop over grid points
+    } // loop over cells in the current box
 
     n_beckmann_goosse_cells = GlobalSum(m_grid->com, n_beckmann_goosse_cells);
     if (n_beckmann_goosse_cells > 0) {
@@ -804,88 +801,106 @@ DiagnosticList Pico::diagnostics_impl() const {
 }
 
 /*!
- * For each shelf, compute average of a given field over the box with id `box_id`.
+ * Collect owned cells in each box and compute the number of cells and the area of each
+ * (box, shelf) pair.
  *
- * This method is used to get inputs from a previous box for the next one.
+ * Uses one pass over the grid and one reduction, so that the rest of PICO can work with
+ * compact lists of cells instead of sweeping the whole grid once per box.
+ *
+ * Note: shelf and box indexes start from 1. Cells with box indexes outside of [1,
+ * m_n_boxes] are ignored.
  */
-void Pico::compute_box_average(int box_id,
-                               const array::Scalar &field,
-                               const array::Scalar &shelf_mask,
-                               const array::Scalar &box_mask,
-                               std::vector<double> &result) const {
-
-  array::AccessScope list{ &field, &shelf_mask, &box_mask };
-
-  // fill results with zeros
-  result.resize(m_n_shelves);
-  for (int s = 0; s < m_n_shelves; ++s) {
-    result[s] = 0.0;
+void Pico::index_boxes(const array::Scalar &shelf_mask,
+                       const array::Scalar &box_mask,
+                       Boxes &result) const {
+  const int N = (m_n_boxes + 1) * m_n_shelves;
+
+  result.cells.resize(m_n_boxes + 1);
+  for (auto &cells : result.cells) {
+    cells.clear();
   }
 
-  // compute the sum of field in each shelf's box box_id
-  std::vector<int> n_cells(m_n_shelves);
-  {
-    std::vector<int> n_cells_per_box(m_n_shelves, 0);
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j();
+  // local cell counts followed by local box areas
+  std::vector<double> local(2 * N, 0.0);
+  double *n_cells = &local[0], *area = &local[N];
+
+  auto cell_area = m_grid->cell_area();
 
-      int shelf_id = shelf_mask.as_int(i, j);
+  array::AccessScope list{ &shelf_mask, &box_mask };
 
-      if (box_mask.as_int(i, j) == box_id) {
-        n_cells_per_box[shelf_id] += 1;
-        result[shelf_id] += field(i, j);
-      }
+  for (auto p = m_grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    int box_id = box_mask.as_int(i, j);
+
+    if (box_id < 1 or box_id > m_n_boxes) {
+      continue;
     }
-    GlobalSum(m_grid->com, n_cells_per_box.data(), n_cells.data(), m_n_shelves);
-  }
 
-  {
-    std::vector<double> tmp(m_n_shelves);
-    GlobalSum(m_grid->com, result.data(), tmp.data(), m_n_shelves);
-    // copy data
-    result = tmp;
-  }
+    int shelf_id = shelf_mask.as_int(i, j);
+
+    result.cells[box_id].push_back({ i, j, shelf_id });
 
-  for (int s = 0; s < m_n_shelves; ++s) {
-    if (n_cells[s] > 0) {
-      result[s] /= static_cast<double>(n_cells[s]);
+    const int k = box_id * m_n_shelves + shelf_id;
+
+    n_cells[k] += 1.0;
+    if (shelf_id > 0) {
+      area[k] += cell_area;
     }
   }
+
+  std::vector<double> total(2 * N);
+  GlobalSum(m_grid->com, local.data(), total.data(), 2 * N);
+
+  result.n_cells.assign(total.begin(), total.begin() + N);
+  result.area.assign(total.begin() + N, total.end());
 }
 
 /*!
- * For all shelves compute areas of boxes with id `box_id`.
+ * For each shelf, compute averages of given fields over the box with id `box_id`.
  *
- * @param[in] box_mask box index mask
- * @param[out] result resulting box areas.
+ * This method is used to get inputs from a previous box for the next one.
  *
- * Note: shelf and box indexes start from 1.
+ * @param[in] boxes cell lists and cell counts computed by `index_boxes()`
+ * @param[in] box_id box index
+ * @param[in] fields fields to average
+ * @param[out] result `result[f][s]` is the average of `fields[f]` over the box `box_id` of
+ *                    the shelf `s`
  */
-void Pico::compute_box_area(int box_id,
-                            const array::Scalar &shelf_mask,
-                            const array::Scalar &box_mask,
-                            std::vector<double> &result) const {
-  result.resize(m_n_shelves);
-  array::AccessScope list{ &shelf_mask, &box_mask };
+void Pico::compute_box_averages(const Boxes &boxes,
+                                int box_id,
+                                const std::vector<const array::Scalar *> &fields,
+                                std::vector<std::vector<double> > &result) const {
 
-  auto cell_area = m_grid->cell_area();
+  const int n_fields = static_cast<int>(fields.size());
 
-  for (auto p = m_grid->points(); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    int shelf_id = shelf_mask.as_int(i, j);
+  array::AccessScope list;
+  for (const auto *f : fields) {
+    list.add(*f);
+  }
 
-    if (shelf_id > 0 and box_mask.as_int(i, j) == box_id) {
-      result[shelf_id] += cell_area;
+  // compute the sum of each field in each shelf's box box_id
+  std::vector<double> local(n_fields * m_n_shelves, 0.0);
+  for (const auto &cell : boxes.cells[box_id]) {
+    for (int f = 0; f < n_fields; ++f) {
+      local[f * m_n_shelves + cell.shelf_id] += (*fields[f])(cell.i, cell.j);
     }
   }
-  
-  // compute GlobalSum from index 1 to index m_n_shelves-1
-  std::vector<double> result1(m_n_shelves);
-  GlobalSum(m_grid->com, &result[1], &result1[1], m_n_shelves-1);
-  // copy data
-  for (int i = 1; i < m_n_shelves; i++) {
-    result[i] = result1[i];
+
+  std::vector<double> total(local.size());
+  GlobalSum(m_grid->com, local.data(), total.data(), (int)local.size());
+
+  const double *n_cells = &boxes.n_cells[box_id * m_n_shelves];
+
+  result.resize(n_fields);
+  for (int f = 0; f < n_fields; ++f) {
+    result[f].assign(&total[f * m_n_shelves], &total[(f + 1) * m_n_shelves]);
+
+    for (int s = 0; s < m_n_shelves; ++s) {
+      if (n_cells[s] > 0) {
+        result[f][s] /= n_cells[s];
+      }
+    }
   }
 }
 
@@ -78,10 +78,32 @@ private:
                               array::Scalar &Toc_box0,
                               array::Scalar &Soc_box0) const;
 
+  //! Compact lists of cells in all boxes and per-(box, shelf) cell counts and areas.
+  struct Boxes {
+    struct Cell {
+      int i, j, shelf_id;
+    };
+
+    //! `cells[b]` contains owned cells with the box index `b`, in the grid traversal order
+    std::vector<std::vector<Cell> > cells;
+    //! number of cells in a box (all shelf indexes), stored at `b * n_shelves + s`
+    std::vector<double> n_cells;
+    //! areas of boxes (shelf indexes above zero), stored at `b * n_shelves + s`
+    std::vector<double> area;
+  };
+
+  void index_boxes(const array::Scalar &shelf_mask,
+                   const array::Scalar &box_mask,
+                   Boxes &result) const;
+
+  void compute_box_averages(const Boxes &boxes,
+                            int box_id,
+                            const std::vector<const array::Scalar *> &fields,
+                            std::vector<std::vector<double> > &result) const;
+
   void process_box1(const PicoPhysics &physics,
+                    const Boxes &boxes,
                     const array::Scalar &ice_thickness,
-                    const array::Scalar &shelf_mask,
-                    const array::Scalar &box_mask,
                     const array::Scalar &Toc_box0,
                     const array::Scalar &Soc_box0,
                     array::Scalar &basal_melt_rate,
@@ -92,9 +114,8 @@ private:
                     array::Scalar &overturning);
 
   void process_other_boxes(const PicoPhysics &physics,
+                           const Boxes &boxes,
                            const array::Scalar &ice_thickness,
-                           const array::Scalar &shelf_mask,
-                           const array::Scalar &box_mask,
                            array::Scalar &basal_melt_rate,
                            array::Scalar &basal_temperature,
                            array::Scalar &T_star,
@@ -112,18 +133,9 @@ private:
                        array::Scalar &Toc,
                        array::Scalar &Soc);
 
-  void compute_box_average(int box_id,
-                           const array::Scalar &field,
-                           const array::Scalar &shelf_mask,
-                           const array::Scalar &box_mask,
-                           std::vector<double> &result) const;
-
-  void compute_box_area(int box_id,
-                        const array::Scalar &shelf_mask,
-                        const array::Scalar &box_mask,
-                        std::vector<double> &result) const;
-
   int m_n_basins, m_n_boxes, m_n_shelves;
+
+  Boxes m_boxes;
 };
 
 } // end of namespace ocean
@@ -41,7 +41,9 @@ PicoGeometry::PicoGeometry(std::shared_ptr<const Grid> grid)
       m_ocean_mask(grid, "pico_ocean_mask"),
       m_lake_mask(grid, "pico_lake_mask"),
       m_ice_rises(grid, "pico_ice_rise_mask"),
-      m_tmp(grid, "temporary_storage") {
+      m_tmp(grid, "temporary_storage"),
+      m_cell_type_last(grid, "pico_cell_type_last"),
+      m_bed_elevation_last(grid, "pico_bed_elevation_last") {
 
   m_continental_shelf.set_interpolation_type(NEAREST);
   m_boxes.set_interpolation_type(NEAREST);
@@ -64,6 +66,15 @@ PicoGeometry::PicoGeometry(std::shared_ptr<const Grid> grid)
   m_n_basins = 0;
 
   m_tmp_p0 = m_tmp.allocate_proc0_copy();
+
+  m_exclude_ice_rises_last       = false;
+  m_n_boxes_last                 = 0;
+  m_continental_shelf_depth_last = 0.0;
+  m_up_to_date                   = false;
+
+  m_n_updates         = 0;
+  m_n_geometry_reused = 0;
+  m_n_shelf_reused    = 0;
 }
 
 const array::Scalar &PicoGeometry::continental_shelf_mask() const {
@@ -93,6 +104,8 @@ void PicoGeometry::init() {
   m_basin_mask.regrid(opt.filename, io::Default::Nil());
 
   m_n_basins = static_cast<int>(max(m_basin_mask)) + 1;
+
+  m_up_to_date = false;
 }
 
 /*!
@@ -104,6 +117,74 @@ void PicoGeometry::init() {
 void PicoGeometry::update(const array::Scalar &bed_elevation,
                           const array::CellType1 &cell_type) {
 
+  bool exclude_ice_rises = m_config->get_flag("ocean.pico.exclude_ice_rises");
+  double continental_shelf_depth = m_config->get_number("ocean.pico.continental_shelf_depth");
+  int n_boxes = static_cast<int>(m_config->get_number("ocean.pico.number_of_boxes"));
+
+  // Detect changes in inputs since the last call. Most of the time the cell type mask does
+  // not change from one ocean model update to the next, so we can skip the expensive
+  // computations below (several connected component labeling passes, all on rank 0).
+  bool geometry_changed = true;
+  bool bed_changed      = true;
+  {
+    // number of changed cells in the cell type mask and the bed elevation
+    double changes[2] = {0.0, 0.0};
+
+    array::AccessScope list{ &cell_type, &bed_elevation, &m_cell_type_last,
+                             &m_bed_elevation_last };
+
+    for (auto p = m_grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      if (cell_type(i, j) != m_cell_type_last(i, j)) {
+        changes[0] += 1.0;
+        m_cell_type_last(i, j) = cell_type(i, j);
+      }
+
+      if (bed_elevation(i, j) != m_bed_elevation_last(i, j)) {
+        changes[1] += 1.0;
+        m_bed_elevation_last(i, j) = bed_elevation(i, j);
+      }
+    }
+
+    double total_changes[2] = {0.0, 0.0};
+    GlobalSum(m_grid->com, changes, total_changes, 2);
+
+    if (m_up_to_date) {
+      geometry_changed = (total_changes[0] > 0.0 or
+                          exclude_ice_rises != m_exclude_ice_rises_last or
+                          n_boxes != m_n_boxes_last);
+      bed_changed      = (total_changes[1] > 0.0 or
+                          continental_shelf_depth != m_continental_shelf_depth_last);
+    }
+
+    m_exclude_ice_rises_last       = exclude_ice_rises;
+    m_n_boxes_last                 = n_boxes;
+    m_continental_shelf_depth_last = continental_shelf_depth;
+    m_up_to_date                   = true;
+  }
+
+  m_n_updates += 1;
+
+  if (not geometry_changed) {
+    m_n_geometry_reused += 1;
+
+    // the continental shelf mask depends on the ice rise mask (i.e. the cell type) and the
+    // bed elevation
+    if (bed_changed) {
+      compute_continental_shelf_mask(bed_elevation, m_ice_rises, continental_shelf_depth,
+                                     m_continental_shelf);
+    } else {
+      m_n_shelf_reused += 1;
+    }
+
+    m_log->message(3,
+                   "PICO: cell type mask did not change; re-using PICO geometry"
+                   " (%d of %d updates), continental shelf mask (%d of %d updates)\n",
+                   m_n_geometry_reused, m_n_updates, m_n_shelf_reused, m_n_updates);
+    return;
+  }
+
   // Update basin adjacency.
   //
   // basin_neighbors() below uses the cell type mask to find
@@ -126,8 +207,6 @@ void PicoGeometry::update(const array::Scalar &bed_elevation,
     }
   }
 
-  bool exclude_ice_rises = m_config->get_flag("ocean.pico.exclude_ice_rises");
-
   // these three could be done at the same time
   {
     compute_ice_rises(cell_type, exclude_ice_rises, m_ice_rises);
@@ -162,14 +241,10 @@ void PicoGeometry::update(const array::Scalar &bed_elevation,
                       most_shelf_cells_in_basin, cfs_in_basins_per_shelf, n_shelves,
                       m_ice_shelves);
 
-    double continental_shelf_depth = m_config->get_number("ocean.pico.continental_shelf_depth");
-
     compute_continental_shelf_mask(bed_elevation, m_ice_rises, continental_shelf_depth,
                                    m_continental_shelf);
   }
 
-  int n_boxes = static_cast<int>(m_config->get_number("ocean.pico.number_of_boxes"));
-
   compute_box_mask(m_distance_gl, m_distance_cf, m_ice_shelves, n_boxes, m_boxes);
 }
 
@@ -119,6 +119,22 @@ private:
 
   int m_n_basins;
   std::vector<std::set<int> > m_basin_neighbors;
+
+  // Inputs and parameters used during the last update() call. Used to skip re-computing
+  // masks when inputs did not change.
+  array::Scalar m_cell_type_last;
+  array::Scalar m_bed_elevation_last;
+  bool m_exclude_ice_rises_last;
+  int m_n_boxes_last;
+  double m_continental_shelf_depth_last;
+  //! true if outputs correspond to inputs stored above
+  bool m_up_to_date;
+
+  // statistics: the number of update() calls and the number of times geometry and the
+  // continental shelf mask were re-used
+  int m_n_updates;
+  int m_n_geometry_reused;
+  int m_n_shelf_reused;
 };
 
 } // end of namespace ocean
@@ -0,0 +1,154 @@
+// Copyright (C) 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "Compares throughput of the scalar and batched implementations of the three equation\n"
+  "sub-shelf melt parameterization (ocean model 'th') using synthetic ocean fields.\n\n";
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mpi.h>
+#include <vector>
+
+#include "pism/coupler/ocean/GivenTH.hh"
+#include "pism/util/ConfigInterface.hh"
+#include "pism/util/Context.hh"
+#include "pism/util/Logger.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/petscwrappers/PetscInitializer.hh"
+#include "pism/util/pism_options.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+
+/*!
+ * Pseudo-random number in [0, 1] depending on `k` and `seed` only.
+ */
+static double noise(int k, int seed) {
+  uint32_t h = (uint32_t)k * 374761393u + (uint32_t)seed * 668265263u;
+  h = (h ^ (h >> 13)) * 1274126177u;
+  h = h ^ (h >> 16);
+  return h / 4294967295.0;
+}
+
+/*!
+ * Create synthetic inputs: ice shelves thinning from 2000 m to 200 m (with some ice-free
+ * cells), sea water potential temperature from -2.5 to 2 degrees Celsius and salinity
+ * around 34.5 g/kg (with some values outside of [4, 40] g/kg). This exercises the melt,
+ * freeze-on and diffusion-only cases.
+ */
+static void create_inputs(int n_cells,
+                          std::vector<double> &salinity,
+                          std::vector<double> &theta,
+                          std::vector<double> &thickness) {
+  salinity.resize(n_cells);
+  theta.resize(n_cells);
+  thickness.resize(n_cells);
+
+  for (int k = 0; k < n_cells; ++k) {
+    double x = (double)k / n_cells;
+
+    thickness[k] = noise(k, 1) < 0.1 ? 0.0 : 2000.0 - 1800.0 * x + 100.0 * noise(k, 2);
+    theta[k]     = -2.5 + 4.5 * noise(k, 3);
+    salinity[k]  = noise(k, 4) < 0.02 ? 50.0 * noise(k, 5) : 34.5 + 0.5 * (noise(k, 6) - 0.5);
+  }
+}
+
+} // end of namespace pism
+
+int main(int argc, char *argv[]) {
+  using namespace pism;
+  using ocean::GivenTH;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  try {
+    auto ctx = context_from_options(com, "given_th_benchmark");
+    auto log = ctx->log();
+
+    std::string usage =
+      "  given_th_benchmark [-n N] [-repeat N]\n"
+      "where\n"
+      "  -n        number of grid cells\n"
+      "  -repeat   number of repetitions\n";
+
+    bool done = show_usage_check_req_opts(*log, "GIVEN_TH_BENCHMARK (sub-shelf melt benchmark)",
+                                          {}, usage);
+    if (done) {
+      return 0;
+    }
+
+    options::Integer n_cells("-n", "number of grid cells", 1000000);
+    options::Integer n_repeat("-repeat", "number of repetitions", 10);
+
+    GivenTH::Constants constants(*ctx->config());
+
+    std::vector<double> salinity, theta, thickness;
+    create_inputs(n_cells, salinity, theta, thickness);
+
+    std::vector<double>
+      T_scalar(n_cells), M_scalar(n_cells),
+      T_batch(n_cells), M_batch(n_cells);
+
+    double time_scalar = 0.0, time_batch = 0.0;
+    for (int r = 0; r < n_repeat; ++r) {
+      double start = get_time(com);
+      for (int k = 0; k < n_cells; ++k) {
+        GivenTH::pointwise_update(constants, salinity[k], theta[k], thickness[k],
+                                  &T_scalar[k], &M_scalar[k]);
+      }
+      time_scalar += get_time(com) - start;
+
+      start = get_time(com);
+      for (int k = 0; k < n_cells; k += GivenTH::batch_size) {
+        int n = std::min(GivenTH::batch_size, n_cells - k);
+        GivenTH::batch_update(constants, n, &salinity[k], &theta[k], &thickness[k],
+                              &T_batch[k], &M_batch[k]);
+      }
+      time_batch += get_time(com) - start;
+    }
+
+    // compare results
+    double max_T_difference = 0.0, max_M_difference = 0.0;
+    int n_melt = 0, n_freeze_on = 0;
+    for (int k = 0; k < n_cells; ++k) {
+      max_T_difference = std::max(max_T_difference, std::abs(T_scalar[k] - T_batch[k]));
+      max_M_difference = std::max(max_M_difference, std::abs(M_scalar[k] - M_batch[k]));
+
+      n_melt += M_scalar[k] > 0.0;
+      n_freeze_on += M_scalar[k] < 0.0;
+    }
+
+    const double seconds_per_year = 365.0 * 86400.0;
+
+    log->message(1, "%d cells (%d with melt, %d with freeze-on)\n", (int)n_cells, n_melt,
+                 n_freeze_on);
+    log->message(1, "scalar:  %.3f ns per cell\n", 1e9 * time_scalar / ((double)n_repeat * n_cells));
+    log->message(1, "batched: %.3f ns per cell (batch size %d)\n",
+                 1e9 * time_batch / ((double)n_repeat * n_cells), GivenTH::batch_size);
+    log->message(1, "max. difference: %e Celsius (temperature), %e m/year (melt rate)\n",
+                 max_T_difference, max_M_difference * seconds_per_year);
+  } catch (...) {
+    handle_fatal_errors(com);
+    return 1;
+  }
+
+  return 0;
+}
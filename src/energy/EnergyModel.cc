@@ -116,6 +116,7 @@ EnergyModel::EnergyModel(std::shared_ptr<const Grid> grid,
   m_ice_enthalpy.metadata(0)
       .long_name("ice enthalpy (includes sensible heat, latent heat, pressure)")
       .units("J kg-1");
+  m_ice_enthalpy.enable_compression();
 
   {
     // ghosted to allow the "redundant" computation of tauc
@@ -18,7 +18,7 @@
  */
 
 #include <algorithm> // std::min, std::max
-#include <cmath>     // std::pow
+#include <cmath>     // std::pow, std::copysign
 
 #include "pism/fracturedensity/FractureDensity.hh"
 #include "pism/geometry/Geometry.hh"
@@ -27,6 +27,87 @@
 
 namespace pism {
 
+namespace details {
+
+//! Number of precursor angles used by the LEFM mixed-mode criterion.
+static const int n_lefm_angles = 45;
+
+/*!
+ * Values of cos(2 beta) and sin(2 beta) for precursor angles beta from 46 to 90 degrees.
+ */
+struct LEFMAngles {
+  LEFMAngles() {
+    for (int k = 0; k < n_lefm_angles; ++k) {
+      double beta = (46 + k) * M_PI / 180.0;
+
+      cos_2beta[k] = cos(2.0 * beta);
+      sin_2beta[k] = sin(2.0 * beta);
+    }
+  }
+  double cos_2beta[n_lefm_angles];
+  double sin_2beta[n_lefm_angles];
+};
+
+/*!
+ * LEFM mixed-mode criterion: maximum (over precursor angles) of the mode I stress
+ * intensity, given principal stresses `T1` and `T2`.
+ *
+ * The crack propagation angle `theta` (eq. 15 in hulbe_ledoux10 or shayam_wu90) is given by
+ * `tan(theta / 2) = t`, where
+ *
+ * `t = -(sqrt(K1^2 + 8 K2^2) - K1) / (4 K2)`.
+ *
+ * Using `cos(theta / 2) = 1 / sqrt(1 + t^2)` and `sin(theta) = 2 t / (1 + t^2)` the mode I
+ * stress intensity
+ *
+ * `K = cos(theta / 2) (K1 cos^2(theta / 2) - 3/2 K2 sin(theta))`
+ *
+ * becomes `(K1 - 3 K2 t) / (1 + t^2)^(3/2)`, avoiding trigonometric functions. Both K1 and
+ * K2 are proportional to `sqrt(pi c)`, so we compute K using stresses and scale the
+ * maximum.
+ */
+static double lefm_stress_intensity(double T1, double T2) {
+  static const LEFMAngles angles;
+
+  if (T1 == 0.0 and T2 == 0.0) {
+    return 0.0;
+  }
+
+  const double
+    mu    = 0.1,                     // friction coefficient between crack faces
+    c     = 0.64 / M_PI,             // initial crack depth 20cm
+    scale = sqrt(M_PI * c),
+    mean  = 0.5 * (T1 + T2),
+    diff  = T1 - T2;
+
+  double K_max = 0.0;
+  for (int k = 0; k < n_lefm_angles; ++k) {
+    // rist_sammonds99
+    double sigma_n   = mean - diff * angles.cos_2beta[k];
+    double sigma_tau = 0.5 * diff * angles.sin_2beta[k];
+
+    // shayam_wu90: in the compressive case Coulomb friction opposes sliding
+    double friction = mu * sigma_n;
+    if (friction < 0.0) {
+      sigma_tau = std::copysign(std::max(std::abs(sigma_tau) - std::abs(friction), 0.0),
+                                sigma_tau);
+    }
+
+    double t = 0.0;
+    if (sigma_tau != 0.0) {
+      t = -(sqrt(sigma_n * sigma_n + 8.0 * sigma_tau * sigma_tau) - sigma_n) / (4.0 * sigma_tau);
+    }
+
+    double s = 1.0 + t * t;
+
+    K_max = std::max(K_max, (sigma_n - 3.0 * sigma_tau * t) / (s * sqrt(s)));
+  }
+
+  return scale * K_max;
+}
+
+} // end of namespace details
+
 FractureDensity::FractureDensity(std::shared_ptr<const Grid> grid,
                                  std::shared_ptr<const rheology::FlowLaw> flow_law)
     : Component(grid),
@@ -284,48 +365,7 @@ void FractureDensity::update(double dt,
 
     ///lefm mixed-mode criterion
     if (lefm) {
-      double sigmamu = 0.1; //friction coefficient between crack faces
-
-      double sigmac = 0.64 / M_PI; //initial crack depth 20cm
-
-      double sigmabetatest, sigmanor, sigmatau, Kone, Ktwo, KSI, KSImax = 0.0, sigmatetanull;
-
-      for (int l = 46; l <= 90; ++l) { //optimize for various precursor angles beta
-        sigmabetatest = l * M_PI / 180.0;
-
-        //rist_sammonds99
-        sigmanor = 0.5 * (T1 + T2) - (T1 - T2) * cos(2 * sigmabetatest);
-        sigmatau = 0.5 * (T1 - T2) * sin(2 * sigmabetatest);
-        //shayam_wu90
-        if (sigmamu * sigmanor < 0.0) { //compressive case
-          if (fabs(sigmatau) <= fabs(sigmamu * sigmanor)) {
-            sigmatau = 0.0;
-          } else {
-            if (sigmatau > 0) { //coulomb friction opposing sliding
-              sigmatau += (sigmamu * sigmanor);
-            } else {
-              sigmatau -= (sigmamu * sigmanor);
-            }
-          }
-        }
-
-        //stress intensity factors
-        Kone = sigmanor * sqrt(M_PI * sigmac); //normal
-        Ktwo = sigmatau * sqrt(M_PI * sigmac); //shear
-
-        if (Ktwo == 0.0) {
-          sigmatetanull = 0.0;
-        } else { //eq15 in hulbe_ledoux10 or eq15 shayam_wu90
-          sigmatetanull = -2.0 * atan((sqrt(pow(Kone, 2) + 8.0 * pow(Ktwo, 2)) - Kone) / (4.0 * Ktwo));
-        }
-
-        KSI = cos(0.5 * sigmatetanull) *
-              (Kone * cos(0.5 * sigmatetanull) * cos(0.5 * sigmatetanull) - 0.5 * 3.0 * Ktwo * sin(sigmatetanull));
-        // mode I stress intensity
-
-        KSImax = std::max(KSI, KSImax);
-      }
-      sigmat = KSImax;
+      sigmat = details::lefm_stress_intensity(T1, T2);
     }
 
     //////////////////////////////////////////////////////////////////////////////
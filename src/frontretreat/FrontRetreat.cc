@@ -30,7 +30,8 @@ namespace pism {
 FrontRetreat::FrontRetreat(std::shared_ptr<const Grid> g)
   : Component(g),
     m_cell_type(m_grid, "cell_type"),
-    m_tmp(m_grid, "temporary_storage") {
+    m_tmp(m_grid, "temporary_storage"),
+    m_front(m_grid) {
 
   m_tmp.metadata(0).long_name("additional mass loss at points near the front").units("m");
   m_cell_type.metadata(0).long_name("cell type mask");
@@ -39,38 +40,56 @@ FrontRetreat::FrontRetreat(std::shared_ptr<const Grid> g)
 /*!
  * Compute the modified mask to avoid "wrapping around" of front retreat at domain
  * boundaries.
+ *
+ * Copies `input` and marks ghost cells outside the computational domain as ice-free
+ * ocean, visiting only these ghost cells.
  */
 void FrontRetreat::compute_modified_mask(const array::CellType1 &input,
                                          array::CellType1 &output) const {
 
-  array::AccessScope list{&input, &output};
+  // note: copy_from() updates ghosts
+  output.copy_from(input);
 
-  const int Mx = m_grid->Mx();
-  const int My = m_grid->My();
+  array::AccessScope list{&output};
 
-  ParallelSection loop(m_grid->com);
-  try {
-    for (auto p = m_grid->points(1); p; p.next()) {
-      const int i = p.i(), j = p.j();
+  const int
+    Mx = m_grid->Mx(),
+    My = m_grid->My(),
+    xs = m_grid->xs(),
+    ys = m_grid->ys(),
+    xm = m_grid->xm(),
+    ym = m_grid->ym();
 
-      if (i < 0 or i >= Mx or j < 0 or j >= My) {
+  // columns of ghosts to the west and east of the domain (including corners)
+  for (int i : {xs - 1, xs + xm}) {
+    if (i < 0 or i >= Mx) {
+      for (int j = ys - 1; j <= ys + ym; ++j) {
+        output(i, j) = MASK_ICE_FREE_OCEAN;
+      }
+    }
+  }
+
+  // rows of ghosts to the south and north of the domain (including corners)
+  for (int j : {ys - 1, ys + ym}) {
+    if (j < 0 or j >= My) {
+      for (int i = xs - 1; i <= xs + xm; ++i) {
         output(i, j) = MASK_ICE_FREE_OCEAN;
-      } else {
-        output(i, j) = input(i, j);
       }
     }
-  } catch (...) {
-    loop.failed();
   }
-  loop.check();
 }
 
 /*!
- * Compute the maximum time step length provided a horizontal retreat rate.
+ * Compute the maximum time step length provided a horizontal retreat rate using the
+ * current sub-domain only.
+ *
+ * The global time step restriction is the minimum of local ones (see
+ * MaxTimestepReduction). This makes it possible to combine the reduction needed here
+ * with others.
  */
-MaxTimestep FrontRetreat::max_timestep(const array::CellType1 &cell_type,
-                                       const array::Scalar &bc_mask,
-                                       const array::Scalar &retreat_rate) const {
+MaxTimestep FrontRetreat::max_timestep_local(const array::CellType1 &cell_type,
+                                             const array::Scalar &bc_mask,
+                                             const array::Scalar &retreat_rate) const {
 
   auto grid = retreat_rate.grid();
   auto sys = grid->ctx()->unit_system();
@@ -80,52 +99,28 @@ MaxTimestep FrontRetreat::max_timestep(const array::CellType1 &cell_type,
   // About 9 hours which corresponds to 10000 km year-1 on a 10 km grid
   double dt_min = convert(sys, 0.001, "years", "seconds");
 
-  double
-    retreat_rate_max  = 0.0,
-    retreat_rate_mean = 0.0;
-  int N_cells = 0;
+  double retreat_rate_max = 0.0;
+
+  m_front.update(cell_type);
 
   array::AccessScope list{&cell_type, &bc_mask, &retreat_rate};
 
-  for (auto pt = grid->points(); pt; pt.next()) {
-    const int i = pt.i(), j = pt.j();
+  for (const auto &pt : m_front.ice_free()) {
+    const int i = pt.i, j = pt.j;
 
     if (cell_type.ice_free_ocean(i, j) and
         cell_type.next_to_ice(i, j) and
         bc_mask(i, j) < 0.5) {
       // NB: this condition has to match the one in update_geometry()
-
-      const double C = retreat_rate(i, j);
-
-      N_cells           += 1;
-      retreat_rate_mean += C;
-      retreat_rate_max   = std::max(C, retreat_rate_max);
+      retreat_rate_max = std::max(retreat_rate(i, j), retreat_rate_max);
     }
   }
 
-  N_cells           = GlobalSum(grid->com, N_cells);
-  retreat_rate_mean = GlobalSum(grid->com, retreat_rate_mean);
-  retreat_rate_max  = GlobalMax(grid->com, retreat_rate_max);
-
-  if (N_cells > 0.0) {
-    retreat_rate_mean /= N_cells;
-  } else {
-    retreat_rate_mean = 0.0;
-  }
-
   double denom = retreat_rate_max / grid->dx();
   const double epsilon = convert(sys, 0.001 / (grid->dx() + grid->dy()), "seconds", "years");
 
   double dt = 1.0 / (denom + epsilon);
 
-  m_log->message(3,
-                 "  frontal retreat: maximum rate = %.2f m/year gives dt=%.5f years\n"
-                 "                   mean rate    = %.2f m/year over %d cells\n",
-                 convert(m_sys, retreat_rate_max, "m second-1", "m year-1"),
-                 convert(m_sys, dt, "seconds", "years"),
-                 convert(m_sys, retreat_rate_mean, "m second-1", "m year-1"),
-                 N_cells);
-
   return MaxTimestep(std::max(dt, dt_min), "front_retreat");
 }
 
@@ -161,6 +156,8 @@ void FrontRetreat::update_geometry(double dt,
 
   const double dx = m_grid->dx();
 
+  m_front.update(m_cell_type);
+
   m_tmp.set(0.0);
 
   array::AccessScope list{&ice_thickness, &bc_mask,
@@ -168,14 +165,14 @@ void FrontRetreat::update_geometry(double dt,
       &surface_elevation};
 
   // Step 1: Apply the computed horizontal retreat rate:
-  for (auto pt = m_grid->points(); pt; pt.next()) {
-    const int i = pt.i(), j = pt.j();
+  for (const auto &pt : m_front.ice_free()) {
+    const int i = pt.i, j = pt.j;
 
     // apply retreat rate at the margin (i.e. to partially-filled cells) only
     if (m_cell_type.ice_free_ocean(i, j) and
         m_cell_type.next_to_ice(i, j) and
         bc_mask(i, j) < 0.5) {
-      // NB: this condition has to match the one in max_timestep()
+      // NB: this condition has to match the one in max_timestep_local()
 
       const double
         rate     = retreat_rate(i, j),
@@ -234,13 +231,15 @@ void FrontRetreat::update_geometry(double dt,
       }
 
     } // end of "if ice free ocean next to ice and not a BC location "
-  }   // end of loop over grid points
+  }   // end of loop over cells near the front
 
   // Step 2: update ice thickness and Href in neighboring cells if we need to propagate mass losses.
+  //
+  // Only icy cells next to ice-free cells can have neighbors with non-zero m_tmp.
   m_tmp.update_ghosts();
 
-  for (auto p = m_grid->points(); p; p.next()) {
-    const int i = p.i(), j = p.j();
+  for (const auto &p : m_front.icy()) {
+    const int i = p.i, j = p.j;
 
     // Note: this condition has to match the one in step 1 above.
     if (bc_mask.as_int(i, j) == 0 and
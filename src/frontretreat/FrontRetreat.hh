@@ -23,6 +23,7 @@
 #include "pism/util/Component.hh"
 #include "pism/util/array/CellType.hh"
 #include "pism/util/MaxTimestep.hh"
+#include "pism/frontretreat/util/FrontIndex.hh"
 
 namespace pism {
 
@@ -45,9 +46,9 @@ public:
                        array::Scalar &Href,
                        array::Scalar1 &ice_thickness);
 
-  MaxTimestep max_timestep(const array::CellType1 &cell_type,
-                           const array::Scalar &bc_mask,
-                           const array::Scalar &retreat_rate) const;
+  MaxTimestep max_timestep_local(const array::CellType1 &cell_type,
+                                 const array::Scalar &bc_mask,
+                                 const array::Scalar &retreat_rate) const;
 private:
 
   void compute_modified_mask(const array::CellType1 &input,
@@ -61,6 +62,8 @@ private:
   // Temporary storage for distributing ice loss to "full" (as opposed to "partially
   // filled") cells near the front
   array::Scalar1 m_tmp;
+  // Cells near the front. Mutable because it is a cache updated by max_timestep_local().
+  mutable FrontIndex m_front;
 };
 
 } // end of namespace pism
@@ -75,11 +75,16 @@ void EigenCalving::update(const array::CellType &cell_type,
                                                    m_strain_rates);
   m_strain_rates.update_ghosts();
 
+  // the calving rate is zero away from the calving front
+  reset_calving_rate();
+
+  m_front.update(m_cell_type);
+
   array::AccessScope list{&m_cell_type, &m_calving_rate, &m_strain_rates};
 
   // Compute the horizontal calving rate
-  for (auto pt = m_grid->points(); pt; pt.next()) {
-    const int i = pt.i(), j = pt.j();
+  for (const auto &pt : m_front.ice_free()) {
+    const int i = pt.i, j = pt.j;
 
     // Find partially filled or empty grid boxes on the icefree ocean, which
     // have floating ice neighbors after the mass continuity step
@@ -126,11 +131,8 @@ void EigenCalving::update(const array::CellType &cell_type,
       } else {
         m_calving_rate(i, j) = 0.0;
       }
-
-    } else { // end of "if (ice_free_ocean and next_to_floating)"
-      m_calving_rate(i, j) = 0.0;
-    }
-  } // end of the loop over grid points
+    } // end of "if (ice_free_ocean and next_to_floating)"
+  } // end of the loop over cells near the front
 }
 
 DiagnosticList EigenCalving::diagnostics_impl() const {
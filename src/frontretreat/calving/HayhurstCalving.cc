@@ -28,12 +28,16 @@ namespace calving {
 
 HayhurstCalving::HayhurstCalving(std::shared_ptr<const Grid> grid)
   : Component(grid),
-    m_calving_rate(grid, "hayhurst_calving_rate")
+    m_calving_rate(grid, "hayhurst_calving_rate"),
+    m_front(grid)
 {
   m_calving_rate.metadata(0)
       .long_name("horizontal calving rate due to Hayhurst calving")
       .units("m s-1")
       .output_units("m day-1");
+
+  // update() relies on this
+  m_calving_rate.set(0.0);
 }
 
 void HayhurstCalving::init() {
@@ -78,8 +82,19 @@ void HayhurstCalving::update(const array::CellType1 &cell_type,
   array::AccessScope list{&ice_thickness, &cell_type, &m_calving_rate, &sea_level,
                                &bed_elevation};
 
-  for (auto pt = m_grid->points(); pt; pt.next()) {
-    const int i = pt.i(), j = pt.j();
+  // The calving rate is computed at icy cells next to ice-free cells and at ice-free
+  // cells next to icy cells (and is zero elsewhere). Reset it at the previous front
+  // position: this is cheaper than resetting it in the whole domain.
+  for (const auto *points : { &m_front.icy(), &m_front.ice_free() }) {
+    for (const auto &pt : *points) {
+      m_calving_rate(pt.i, pt.j) = 0.0;
+    }
+  }
+
+  m_front.update(cell_type);
+
+  for (const auto &pt : m_front.icy()) {
+    const int i = pt.i, j = pt.j;
 
     double water_depth = sea_level(i, j) - bed_elevation(i, j);
 
@@ -113,37 +128,32 @@ void HayhurstCalving::update(const array::CellType1 &cell_type,
       m_calving_rate(i, j) = (m_B_tilde * unit_scaling *
                               (1.0 - pow(omega, 2.8)) *
                               pow(sigma_0 - m_sigma_threshold, m_exponent_r) * H);
-    } else { // end of "if (ice_free_ocean and next_to_floating)"
-      m_calving_rate(i, j) = 0.0;
-    }
-  }   // end of loop over grid points
+    } // end of "if (icy and water_depth > 0)"
+  }   // end of loop over icy cells near the front
 
   // Set calving rate *near* grounded termini to the average of grounded icy
-  // neighbors: front retreat code uses values at these locations (the rest is for
-  // visualization).
+  // neighbors: front retreat code uses values at these locations (values at icy cells
+  // are for visualization).
 
   m_calving_rate.update_ghosts();
 
-  for (auto p = m_grid->points(); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    if (cell_type.ice_free(i, j) and cell_type.next_to_ice(i, j) ) {
+  for (const auto &p : m_front.ice_free()) {
+    const int i = p.i, j = p.j;
 
-      auto R = m_calving_rate.star(i, j);
-      auto M = cell_type.star(i, j);
+    auto R = m_calving_rate.star(i, j);
+    auto M = cell_type.star(i, j);
 
-      int N = 0;
-      double R_sum = 0.0;
-      for (auto d : {North, East, South, West}) {
-        if (mask::icy(M[d])) {
-          R_sum += R[d];
-          N++;
-        }
+    int N = 0;
+    double R_sum = 0.0;
+    for (auto d : {North, East, South, West}) {
+      if (mask::icy(M[d])) {
+        R_sum += R[d];
+        N++;
       }
+    }
 
-      if (N > 0) {
-        m_calving_rate(i, j) = R_sum / N;
-      }
+    if (N > 0) {
+      m_calving_rate(i, j) = R_sum / N;
     }
   }
 }
@@ -23,6 +23,7 @@
 #include "pism/util/Component.hh"
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/array/CellType.hh"
+#include "pism/frontretreat/util/FrontIndex.hh"
 
 namespace pism {
 
@@ -48,6 +49,9 @@ protected:
 protected:
   array::Scalar1 m_calving_rate;
 
+  //! cells near the calving front
+  FrontIndex m_front;
+
   double m_B_tilde, m_exponent_r, m_sigma_threshold;
 
 };
@@ -28,7 +28,8 @@ StressCalving::StressCalving(std::shared_ptr<const Grid> grid,
     m_stencil_width(stencil_width),
     m_strain_rates(m_grid, "strain_rates", array::WITH_GHOSTS, 2),
     m_calving_rate(m_grid, "calving_rate"),
-    m_cell_type(m_grid, "cell_type")
+    m_cell_type(m_grid, "cell_type"),
+    m_front(m_grid)
 {
 
   m_strain_rates.metadata(0).set_name("eigen1");
@@ -47,6 +48,24 @@ StressCalving::StressCalving(std::shared_ptr<const Grid> grid,
       .output_units("m year-1");
 
   m_cell_type.metadata(0).long_name("cell type mask");
+
+  // reset_calving_rate() relies on this
+  m_calving_rate.set(0.0);
+}
+
+/*!
+ * Set the calving rate to zero at the front position used during the previous update.
+ *
+ * Non-zero calving rates are computed at cells near the front only, so this is
+ * equivalent to resetting the calving rate in the whole domain. Has to be called
+ * *before* `m_front.update()`.
+ */
+void StressCalving::reset_calving_rate() {
+  array::AccessScope list{ &m_calving_rate };
+
+  for (const auto &pt : m_front.ice_free()) {
+    m_calving_rate(pt.i, pt.j) = 0.0;
+  }
 }
 
 const array::Scalar &StressCalving::calving_rate() const {
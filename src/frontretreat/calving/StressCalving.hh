@@ -24,6 +24,7 @@
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/array/Array2D.hh"
 #include "pism/util/array/CellType.hh"
+#include "pism/frontretreat/util/FrontIndex.hh"
 #include "pism/stressbalance/StressBalance.hh" // struct PrincipalStrainRates
 
 namespace pism {
@@ -39,6 +40,8 @@ public:
   const array::Scalar &calving_rate() const;
 
 protected:
+  void reset_calving_rate();
+
   const int m_stencil_width;
 
   array::Array2D<stressbalance::PrincipalStrainRates> m_strain_rates;
@@ -46,6 +49,9 @@ protected:
   array::Scalar m_calving_rate;
 
   array::CellType1 m_cell_type;
+
+  //! cells near the calving front
+  FrontIndex m_front;
 };
 
 
@@ -117,6 +117,11 @@ void vonMisesCalving::update(const array::CellType1 &cell_type,
                                                    m_strain_rates);
   m_strain_rates.update_ghosts();
 
+  // the calving rate is zero away from the calving front
+  reset_calving_rate();
+
+  m_front.update(m_cell_type);
+
   array::AccessScope list{&ice_enthalpy, &ice_thickness, &m_cell_type, &ice_velocity,
                                &m_strain_rates, &m_calving_rate, &m_calving_threshold};
 
@@ -124,8 +129,8 @@ void vonMisesCalving::update(const array::CellType1 &cell_type,
 
   double glen_exponent = m_flow_law->exponent();
 
-  for (auto pt = m_grid->points(); pt; pt.next()) {
-    const int i = pt.i(), j = pt.j();
+  for (const auto &pt : m_front.ice_free()) {
+    const int i = pt.i, j = pt.j;
 
     // Find partially filled or empty grid boxes on the icefree ocean, which
     // have floating ice neighbors after the mass continuity step
@@ -187,11 +192,8 @@ void vonMisesCalving::update(const array::CellType1 &cell_type,
 
       // Calving law [\ref Morlighem2016] equation 4
       m_calving_rate(i, j) = velocity_magnitude * sigma_tilde / m_calving_threshold(i, j);
-
-    } else { // end of "if (ice_free_ocean and next_to_floating)"
-      m_calving_rate(i, j) = 0.0;
-    }
-  }   // end of loop over grid points
+    } // end of "if (ice_free_ocean and next_to_ice)"
+  }   // end of loop over cells near the front
 }
 
 const array::Scalar& vonMisesCalving::threshold() const {
@@ -0,0 +1,146 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>            // std::remove_if, std::sort
+#include <limits>
+
+#include "pism/frontretreat/util/FrontIndex.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/array/CellType.hh"
+
+namespace pism {
+
+FrontIndex::FrontIndex(std::shared_ptr<const Grid> grid)
+  : m_grid(grid) {
+  size_t size = (grid->xm() + 2) * (grid->ym() + 2);
+
+  // this value is not a valid cell type, so the first call to update() classifies all
+  // cells
+  m_cell_type.resize(size, std::numeric_limits<int>::min());
+  m_kind.resize(size, INTERIOR);
+}
+
+//! Index of the point `(i, j)` (owned or in the width-1 halo) in internal arrays.
+int FrontIndex::index(int i, int j) const {
+  return (j - m_grid->ys() + 1) * (m_grid->xm() + 2) + (i - m_grid->xs() + 1);
+}
+
+FrontIndex::Kind FrontIndex::classify(const array::CellType1 &cell_type, int i, int j) const {
+  if (cell_type.ice_free(i, j) and cell_type.next_to_ice(i, j)) {
+    return ICE_FREE_MARGIN;
+  }
+
+  if (cell_type.ice_margin(i, j)) {
+    return ICY_MARGIN;
+  }
+
+  return INTERIOR;
+}
+
+/*!
+ * Update lists of cells near the ice margin.
+ *
+ * `cell_type` has to have up-to-date ghosts.
+ */
+void FrontIndex::update(const array::CellType1 &cell_type) {
+  const int
+    xs = m_grid->xs(),
+    ys = m_grid->ys(),
+    xm = m_grid->xm(),
+    ym = m_grid->ym();
+
+  auto owned = [=](int i, int j) {
+    return i >= xs and i < xs + xm and j >= ys and j < ys + ym;
+  };
+
+  // Find owned cells that have to be re-classified: cells with at least one changed cell
+  // in their 5-point stencil. This list may contain duplicates.
+  std::vector<Point> changed;
+
+  array::AccessScope list{ &cell_type };
+
+  for (auto p = m_grid->points(1); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    int &old_value = m_cell_type[index(i, j)];
+    int value      = cell_type.as_int(i, j);
+
+    if (value == old_value) {
+      continue;
+    }
+    old_value = value;
+
+    for (auto q : { Point{ i, j }, Point{ i + 1, j }, Point{ i - 1, j }, Point{ i, j + 1 },
+                    Point{ i, j - 1 } }) {
+      if (owned(q.i, q.j)) {
+        changed.push_back(q);
+      }
+    }
+  }
+
+  bool modified = false;
+  for (const auto &p : changed) {
+    Kind &old_kind = m_kind[index(p.i, p.j)];
+    Kind kind      = classify(cell_type, p.i, p.j);
+
+    if (kind == old_kind) {
+      continue;
+    }
+    old_kind = kind;
+    modified = true;
+
+    if (kind == ICE_FREE_MARGIN) {
+      m_ice_free.push_back(p);
+    } else if (kind == ICY_MARGIN) {
+      m_icy.push_back(p);
+    }
+  }
+
+  if (not modified) {
+    return;
+  }
+
+  // remove cells that changed their classification and restore the order
+  auto prune = [this](std::vector<Point> &points, Kind kind) {
+    points.erase(std::remove_if(points.begin(), points.end(),
+                                [this, kind](const Point &p) {
+                                  return m_kind[index(p.i, p.j)] != kind;
+                                }),
+                 points.end());
+
+    std::sort(points.begin(), points.end(), [](const Point &a, const Point &b) {
+      return a.j < b.j or (a.j == b.j and a.i < b.i);
+    });
+  };
+
+  prune(m_ice_free, ICE_FREE_MARGIN);
+  prune(m_icy, ICY_MARGIN);
+}
+
+//! Owned ice-free cells with at least one icy neighbor.
+const std::vector<FrontIndex::Point> &FrontIndex::ice_free() const {
+  return m_ice_free;
+}
+
+//! Owned icy cells with at least one ice-free neighbor.
+const std::vector<FrontIndex::Point> &FrontIndex::icy() const {
+  return m_icy;
+}
+
+} // end of namespace pism
@@ -0,0 +1,84 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_FRONTINDEX_H
+#define PISM_FRONTINDEX_H
+
+#include <memory>
+#include <vector>
+
+namespace pism {
+
+class Grid;
+
+namespace array {
+class CellType1;
+}
+
+/*!
+ * Sparse index of grid cells next to the ice margin in the sub-domain owned by the current
+ * process.
+ *
+ * Calving and front retreat code does real work only near the ice margin. This class
+ * maintains lists of
+ *
+ * - ice-free cells that have at least one icy neighbor (see `ice_free()`) and
+ * - icy cells that have at least one ice-free neighbor (see `icy()`)
+ *
+ * using 4-connectivity, so that these computations cost O(front length) instead of O(area).
+ *
+ * `update()` compares the cell type mask to the copy saved during the previous call and
+ * re-classifies only cells in the neighborhood of changed cells. Lists are sorted
+ * (`j` first, then `i`) to preserve the memory access pattern of a loop over the grid.
+ */
+class FrontIndex {
+public:
+  FrontIndex(std::shared_ptr<const Grid> grid);
+
+  struct Point {
+    int i;
+    int j;
+  };
+
+  void update(const array::CellType1 &cell_type);
+
+  const std::vector<Point> &ice_free() const;
+  const std::vector<Point> &icy() const;
+
+private:
+  enum Kind : char { INTERIOR = 0, ICE_FREE_MARGIN = 1, ICY_MARGIN = 2 };
+
+  int index(int i, int j) const;
+
+  Kind classify(const array::CellType1 &cell_type, int i, int j) const;
+
+  std::shared_ptr<const Grid> m_grid;
+
+  //! copy of the cell type mask (including the width-1 halo)
+  std::vector<int> m_cell_type;
+  //! classification of cells in the owned sub-domain
+  std::vector<Kind> m_kind;
+
+  std::vector<Point> m_ice_free;
+  std::vector<Point> m_icy;
+};
+
+} // end of namespace pism
+
+#endif /* PISM_FRONTINDEX_H */
@@ -17,6 +17,9 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <algorithm>            // std::min, std::max
+#include <vector>
+
 #include "pism/geometry/GeometryEvolution.hh"
 
 #include "pism/util/Grid.hh"
@@ -44,6 +47,80 @@ using mask::ice_free_land;
 using mask::ice_free_ocean;
 using mask::icy;
 
+namespace {
+
+//! A rectangular block of grid cells in the sub-domain owned by a process.
+struct Tile {
+  //! Type of all cells in a tile and its width-1 halo (`MIXED` if they are not all
+  //! of the same type).
+  enum Type { MIXED, GROUNDED, FLOATING, ICE_FREE };
+
+  int xs, ys, xm, ym;
+  Type type;
+};
+
+//! Indexes of a grid cell.
+struct Cell {
+  int i;
+  int j;
+};
+
+//! Size (in grid cells) of tiles used to specialize mass transport computations.
+const int tile_size = 16;
+
+/*!
+ * Split the sub-domain owned by the current process into tiles and classify them
+ * using `cell_type`.
+ *
+ * Homogeneous tiles (tiles with all cells in the tile *and its width-1 halo* of the
+ * same type) can be processed using simpler code.
+ */
+void classify_tiles(const array::CellType1 &cell_type, std::vector<Tile> &result) {
+  auto grid = cell_type.grid();
+
+  result.clear();
+
+  array::AccessScope list{ &cell_type };
+
+  for (int ys = grid->ys(); ys < grid->ys() + grid->ym(); ys += tile_size) {
+    for (int xs = grid->xs(); xs < grid->xs() + grid->xm(); xs += tile_size) {
+      Tile tile;
+      tile.xs = xs;
+      tile.ys = ys;
+      tile.xm = std::min(tile_size, grid->xs() + grid->xm() - xs);
+      tile.ym = std::min(tile_size, grid->ys() + grid->ym() - ys);
+
+      bool
+        grounded = true,
+        floating = true,
+        ice_free = true;
+      for (int j = ys - 1; j <= ys + tile.ym; ++j) {
+        for (int i = xs - 1; i <= xs + tile.xm; ++i) {
+          int M = cell_type.as_int(i, j);
+
+          grounded = grounded and mask::grounded_ice(M);
+          floating = floating and mask::floating_ice(M);
+          ice_free = ice_free and mask::ice_free(M);
+        }
+      }
+
+      if (grounded) {
+        tile.type = Tile::GROUNDED;
+      } else if (floating) {
+        tile.type = Tile::FLOATING;
+      } else if (ice_free) {
+        tile.type = Tile::ICE_FREE;
+      } else {
+        tile.type = Tile::MIXED;
+      }
+
+      result.push_back(tile);
+    }
+  }
+}
+
+} // namespace
+
 struct GeometryEvolution::Impl {
   Impl(std::shared_ptr<const Grid> g);
 
@@ -89,6 +166,10 @@ struct GeometryEvolution::Impl {
   array::CellType1 cell_type;          // updated to maintain consistency
   array::Scalar1 residual;             // temporary storage
   array::Scalar1 thickness;            // temporary storage
+
+  //! Tiles covering the sub-domain, classified using `cell_type` at the beginning of a
+  //! step.
+  std::vector<Tile> tiles;
 };
 
 GeometryEvolution::Impl::Impl(std::shared_ptr<const Grid> grid)
@@ -267,6 +348,9 @@ void GeometryEvolution::flow_step(const Geometry &geometry, double dt,
                        m_impl->ice_thickness,      // in (uses ghosts)
                        m_impl->cell_type,          // out (ghosts are updated)
                        m_impl->surface_elevation); // out (ghosts are updated)
+
+    // Note: compute_interface_fluxes() and update_in_place() use these tiles.
+    classify_tiles(m_impl->cell_type, m_impl->tiles);
   }
   profiling().end("ge.update_ghosted_copies");
 
@@ -564,6 +648,40 @@ static double limit_diffusive_flux(int current, int neighbor, double flux) {
       PISM_ERROR_LOCATION, "cannot handle the case current=%d, neighbor=%d", current, neighbor);
 }
 
+/*!
+ * Compute fluxes through cell interfaces in a tile where all cells (including the halo)
+ * contain grounded (`diffusion == true`) or floating (`diffusion == false`) ice.
+ *
+ * This is equivalent to the general code in compute_interface_fluxes() because
+ * limit_advective_flux() and limit_diffusive_flux() do not modify fluxes between grounded
+ * cells, and in ice shelves the former does not modify the flux while the latter sets it
+ * to zero.
+ */
+template <bool diffusion>
+static void icy_tile_fluxes(const Tile &tile, const array::Scalar &ice_thickness,
+                            const array::Vector &velocity, const array::Staggered &diffusive_flux,
+                            array::Staggered &output) {
+  for (int j = tile.ys; j < tile.ys + tile.ym; ++j) {
+    for (int i = tile.xs; i < tile.xs + tile.xm; ++i) {
+      const double H   = ice_thickness(i, j);
+      const Vector2d V = velocity(i, j);
+
+      for (int n = 0; n < 2; ++n) {
+        const int i_n = i + 1 - n, j_n = j + n;
+
+        // both cells are icy
+        auto v_staggered = (V + velocity(i_n, j_n)) / 2.0;
+        double v         = n == 0 ? v_staggered.u : v_staggered.v;
+
+        // first order upwinding
+        const double Q_advective = v * (v > 0.0 ? H : ice_thickness(i_n, j_n));
+
+        output(i, j, n) = diffusion ? diffusive_flux(i, j, n) + Q_advective : Q_advective;
+      }
+    }
+  }
+}
+
 /*!
  * Combine advective velocity and the diffusive flux on the staggered grid with the ice thickness to
  * compute the total flux through cell interfaces.
@@ -571,6 +689,9 @@ static double limit_diffusive_flux(int current, int neighbor, double flux) {
  * Uses first-order upwinding to compute the advective flux.
  *
  * Limits the diffusive flux to prevent SIA-driven flow in the ocean and ice-free areas.
+ *
+ * Uses tiles classified in flow_step() to skip limiting fluxes in areas away from ice
+ * margins and grounding lines.
  */
 void GeometryEvolution::compute_interface_fluxes(const array::CellType1 &cell_type,
                                                  const array::Scalar &ice_thickness,
@@ -582,59 +703,63 @@ void GeometryEvolution::compute_interface_fluxes(const array::CellType1 &cell_ty
 
   ParallelSection loop(m_grid->com);
   try {
-    // compute advective fluxes and put them in output
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j(), M = cell_type(i, j);
-
-      const double H   = ice_thickness(i, j);
-      const Vector2d V = velocity(i, j);
-
-      for (int n = 0; n < 2; ++n) {
-        const int oi = 1 - n,  // offset in the i direction
-            oj       = n,      // offset in the j direction
-            i_n      = i + oi, // i index of a neighbor
-            j_n      = j + oj; // j index of a neighbor
-
-        const int M_n = cell_type(i_n, j_n);
-
-        // advective velocity at the current interface
-        double v = 0.0;
-        {
-          Vector2d V_n = velocity(i_n, j_n);
-          int W = icy(M), W_n = icy(M_n);
-
-          auto v_staggered = (W * V + W_n * V_n) / std::max(W + W_n, 1);
-          v                = n == 0 ? v_staggered.u : v_staggered.v;
+    for (const auto &tile : m_impl->tiles) {
+      switch (tile.type) {
+      case Tile::GROUNDED:
+        icy_tile_fluxes<true>(tile, ice_thickness, velocity, diffusive_flux, output);
+        continue;
+      case Tile::FLOATING:
+        icy_tile_fluxes<false>(tile, ice_thickness, velocity, diffusive_flux, output);
+        continue;
+      case Tile::ICE_FREE:
+        // no flow in ice-free areas
+        for (int j = tile.ys; j < tile.ys + tile.ym; ++j) {
+          for (int i = tile.xs; i < tile.xs + tile.xm; ++i) {
+            output(i, j, 0) = 0.0;
+            output(i, j, 1) = 0.0;
+          }
         }
+        continue;
+      case Tile::MIXED:
+        break;
+      }
 
-        // advective flux
-        const double H_n         = ice_thickness(i_n, j_n),
-                     Q_advective = v * (v > 0.0 ? H : H_n); // first order upwinding
+      for (int j = tile.ys; j < tile.ys + tile.ym; ++j) {
+        for (int i = tile.xs; i < tile.xs + tile.xm; ++i) {
+          const int M = cell_type(i, j);
 
-        output(i, j, n) = Q_advective;
-      } // end of the loop over neighbors (n)
-    }
+          const double H   = ice_thickness(i, j);
+          const Vector2d V = velocity(i, j);
 
-    // limit the advective flux and add the diffusive flux to it to get the total
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j(), M = cell_type(i, j);
+          for (int n = 0; n < 2; ++n) {
+            const int oi = 1 - n,  // offset in the i direction
+                oj       = n,      // offset in the j direction
+                i_n      = i + oi, // i index of a neighbor
+                j_n      = j + oj; // j index of a neighbor
 
-      for (int n = 0; n < 2; ++n) {
-        const int oi = 1 - n,  // offset in the i direction
-            oj       = n,      // offset in the j direction
-            i_n      = i + oi, // i index of a neighbor
-            j_n      = j + oj; // j index of a neighbor
+            const int M_n = cell_type(i_n, j_n);
 
-        const int M_n = cell_type(i_n, j_n);
+            // advective velocity at the current interface
+            double v = 0.0;
+            {
+              Vector2d V_n = velocity(i_n, j_n);
+              int W = icy(M), W_n = icy(M_n);
 
-        // diffusive flux
-        const double Q_diffusive = limit_diffusive_flux(M, M_n, diffusive_flux(i, j, n)),
-                     Q_advective = limit_advective_flux(M, M_n, output(i, j, n));
+              auto v_staggered = (W * V + W_n * V_n) / std::max(W + W_n, 1);
+              v                = n == 0 ? v_staggered.u : v_staggered.v;
+            }
 
-        output(i, j, n) = Q_diffusive + Q_advective;
-      } // end of the loop over n
-    }
+            // advective flux
+            const double H_n = ice_thickness(i_n, j_n),
+                         Q_advective = v * (v > 0.0 ? H : H_n); // first order upwinding
 
+            // limit the advective flux and add the diffusive flux to it to get the total
+            output(i, j, n) = (limit_diffusive_flux(M, M_n, diffusive_flux(i, j, n)) +
+                               limit_advective_flux(M, M_n, Q_advective));
+          } // end of the loop over neighbors (n)
+        }
+      }
+    } // end of the loop over tiles
   } catch (...) {
     loop.failed();
   }
@@ -721,49 +846,69 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
 
   const double Lz = m_grid->Lz();
 
+  // Note: tiles were classified using the cell type mask computed using the same ice
+  // thickness, so they are consistent with m_impl->cell_type.
+
   ParallelSection loop(m_grid->com);
   try {
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      double divQ = flux_divergence(i, j);
-
-      if (m_impl->use_part_grid) {
-        if (m_impl->cell_type.ice_free_ocean(i, j) and m_impl->cell_type.next_to_ice(i, j)) {
-          assert(divQ <= 0.0);
-          // Add the flow contribution to this partially filled cell.
-          area_specific_volume(i, j) += -divQ * dt;
-
-          double threshold = part_grid_threshold_thickness(
-              m_impl->cell_type.star_int(i, j), m_impl->thickness.star(i, j),
-              m_impl->surface_elevation.star(i, j), bed_topography(i, j));
-
-          // if threshold is zero, turn all the area specific volume into ice thickness, with zero
-          // residual
-          if (threshold == 0.0) {
-            threshold = area_specific_volume(i, j);
+    for (const auto &tile : m_impl->tiles) {
+      if (not m_impl->use_part_grid or tile.type != Tile::MIXED) {
+        // there are no partially-filled cells in homogeneous tiles
+        for (int j = tile.ys; j < tile.ys + tile.ym; ++j) {
+          for (int i = tile.xs; i < tile.xs + tile.xm; ++i) {
+            ice_thickness(i, j) += -dt * flux_divergence(i, j);
+
+            if (ice_thickness(i, j) > Lz) {
+              throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                            "ice thickness would exceed Lz at i=%d, j=%d (H=%f, Lz=%f)",
+                                            i, j, ice_thickness(i, j), Lz);
+            }
           }
+        }
+        continue;
+      }
 
-          if (area_specific_volume(i, j) >= threshold) {
-            ice_thickness(i, j) += threshold;
-            m_impl->residual(i, j)     = area_specific_volume(i, j) - threshold;
-            area_specific_volume(i, j) = 0.0;
+      // general case (part-grid)
+      for (int j = tile.ys; j < tile.ys + tile.ym; ++j) {
+        for (int i = tile.xs; i < tile.xs + tile.xm; ++i) {
+          double divQ = flux_divergence(i, j);
+
+          if (m_impl->cell_type.ice_free_ocean(i, j) and m_impl->cell_type.next_to_ice(i, j)) {
+            assert(divQ <= 0.0);
+            // Add the flow contribution to this partially filled cell.
+            area_specific_volume(i, j) += -divQ * dt;
+
+            double threshold = part_grid_threshold_thickness(
+                m_impl->cell_type.star_int(i, j), m_impl->thickness.star(i, j),
+                m_impl->surface_elevation.star(i, j), bed_topography(i, j));
+
+            // if threshold is zero, turn all the area specific volume into ice thickness, with
+            // zero residual
+            if (threshold == 0.0) {
+              threshold = area_specific_volume(i, j);
+            }
+
+            if (area_specific_volume(i, j) >= threshold) {
+              ice_thickness(i, j) += threshold;
+              m_impl->residual(i, j)     = area_specific_volume(i, j) - threshold;
+              area_specific_volume(i, j) = 0.0;
+            }
+
+            // In this case the flux goes into the area_specific_volume variable and does not
+            // directly contribute to ice thickness at this location.
+            divQ = 0.0;
           }
 
-          // In this case the flux goes into the area_specific_volume variable and does not directly
-          // contribute to ice thickness at this location.
-          divQ = 0.0;
-        }
-      } // end of if (use_part_grid)
+          ice_thickness(i, j) += -dt * divQ;
 
-      ice_thickness(i, j) += -dt * divQ;
-
-      if (ice_thickness(i, j) > Lz) {
-        throw RuntimeError::formatted(PISM_ERROR_LOCATION,
-                                      "ice thickness would exceed Lz at i=%d, j=%d (H=%f, Lz=%f)",
-                                      i, j, ice_thickness(i, j), Lz);
+          if (ice_thickness(i, j) > Lz) {
+            throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                          "ice thickness would exceed Lz at i=%d, j=%d (H=%f, Lz=%f)",
+                                          i, j, ice_thickness(i, j), Lz);
+          }
+        }
       }
-    }
+    } // end of the loop over tiles
   } catch (...) {
     loop.failed();
   }
@@ -771,8 +916,9 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
 
   ice_thickness.update_ghosts();
 
-  // Compute the mask corresponding to the new thickness.
-  m_impl->gc.compute_mask(sea_level, bed_topography, ice_thickness, m_impl->cell_type);
+  // Compute the mask and the surface elevation corresponding to the new thickness.
+  m_impl->gc.compute(sea_level, bed_topography, ice_thickness, m_impl->cell_type,
+                     m_impl->surface_elevation);
 
   /*
     Redistribute residual ice mass from subgrid-scale parameterization.
@@ -782,15 +928,10 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
   if (m_impl->use_part_grid) {
     const int max_n_iterations = m_config->get_number("geometry.part_grid.max_iterations");
 
-    bool done = false;
-    for (int i = 0; i < max_n_iterations and not done; ++i) {
-      m_log->message(4, "redistribution iteration %d\n", i);
-
-      // this call may set done to true
-      residual_redistribution_iteration(bed_topography, sea_level, m_impl->surface_elevation,
-                                        ice_thickness, m_impl->cell_type, area_specific_volume,
-                                        m_impl->residual, done);
-    }
+    bool done = residual_redistribution(max_n_iterations, bed_topography, sea_level,
+                                        m_impl->surface_elevation, ice_thickness,
+                                        m_impl->cell_type, area_specific_volume,
+                                        m_impl->residual);
 
     if (not done) {
       m_log->message(
@@ -811,38 +952,148 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
   }
 }
 
-//! @brief Perform one iteration of the residual mass redistribution.
+//! @brief Redistribute the residual mass produced by the part-grid scheme.
 /*!
-  @param[in] bed_topography bed elevation
-  @param[in] sea_level sea level elevation
-  @param[in,out] ice_surface_elevation surface elevation; used as temp. storage
-  @param[in,out] ice_thickness ice thickness; updated
-  @param[in,out] cell_type cell type mask; used as temp. storage
+  Each iteration
+
+  1. distributes the residual mass equally among adjacent ice-free ocean cells (or adds
+     it to the ice thickness if there are none) and
+  2. converts the area specific volume into ice thickness in partially filled cells that
+     became "full", producing new residuals.
+
+  Each iteration visits only cells with positive residual, cells receiving residual mass
+  and cells with positive area specific volume next to cells where the ice thickness
+  changed (the first iteration also checks all partially-filled cells). Processes
+  exchange ghosts only: there are no sweeps over the whole sub-domain.
+
+  Assumes that `cell_type` and `ice_surface_elevation` are consistent with
+  `ice_thickness` (including ghosts).
+
+  @param[in] max_n_iterations maximum number of iterations
+  @param[in] bed_topography bed elevation (ghosted)
+  @param[in] sea_level sea level elevation (ghosted)
+  @param[in,out] ice_surface_elevation surface elevation; updated
+  @param[in,out] ice_thickness ice thickness (ghosted); updated
+  @param[in,out] cell_type cell type mask; updated
   @param[in,out] area_specific_volume area specific volume; updated
   @param[in,out] residual ice volume that still needs to be distributed; updated
-  @param[in,out] done result flag: true if this iteration should be the last one
+
+  @return true if all the residual mass was redistributed
  */
-void GeometryEvolution::residual_redistribution_iteration(const array::Scalar &bed_topography,
-                                                          const array::Scalar &sea_level,
-                                                          array::Scalar1 &ice_surface_elevation,
-                                                          array::Scalar &ice_thickness,
-                                                          array::CellType1 &cell_type,
-                                                          array::Scalar &area_specific_volume,
-                                                          array::Scalar &residual, bool &done) {
+bool GeometryEvolution::residual_redistribution(int max_n_iterations,
+                                                const array::Scalar &bed_topography,
+                                                const array::Scalar &sea_level,
+                                                array::Scalar1 &ice_surface_elevation,
+                                                array::Scalar &ice_thickness,
+                                                array::CellType1 &cell_type,
+                                                array::Scalar &area_specific_volume,
+                                                array::Scalar1 &residual) {
+  const int
+    xs = m_grid->xs(),
+    ys = m_grid->ys(),
+    xm = m_grid->xm(),
+    ym = m_grid->ym();
+
+  auto owned = [=](int i, int j) {
+    return i >= xs and i < xs + xm and j >= ys and j < ys + ym;
+  };
 
-  m_impl->gc.compute_mask(sea_level, bed_topography, ice_thickness, cell_type);
+  auto index = [=](int i, int j) {
+    return (j - ys) * xm + (i - xs);
+  };
 
-  // First step: distribute residual mass
+  // cells with positive residual
+  std::vector<Cell> active;
+  // cells receiving residual mass
+  std::vector<Cell> receivers;
+  std::vector<bool> is_receiver(xm * ym, false);
+  // cells that have to be checked in step 2 (below)
+  std::vector<Cell> candidates;
+  std::vector<bool> is_candidate(xm * ym, false);
+  // cells where ice thickness changed
+  std::vector<Cell> changed;
+
+  // halo cells next to the owned sub-domain and a copy of ice thickness in these cells
+  std::vector<Cell> halo;
+  std::vector<double> halo_thickness;
   {
-    // will be destroyed at the end of the block
-    array::AccessScope list{ &cell_type, &ice_thickness, &area_specific_volume, &residual };
+    for (int i = xs; i < xs + xm; ++i) {
+      halo.push_back({i, ys - 1});
+      halo.push_back({i, ys + ym});
+    }
+    for (int j = ys; j < ys + ym; ++j) {
+      halo.push_back({xs - 1, j});
+      halo.push_back({xs + xm, j});
+    }
+    halo_thickness.resize(halo.size());
+  }
 
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j();
+  array::AccessScope list{ &bed_topography, &sea_level, &ice_surface_elevation,
+                           &ice_thickness, &cell_type, &area_specific_volume, &residual };
 
-      if (residual(i, j) <= 0.0) {
-        continue;
+  auto add_candidate = [&](int i, int j) {
+    if (owned(i, j) and area_specific_volume(i, j) > 0.0 and not is_candidate[index(i, j)]) {
+      is_candidate[index(i, j)] = true;
+      candidates.push_back({i, j});
+    }
+  };
+
+  // Update ghosts of the ice thickness and re-compute the cell type and the surface
+  // elevation where the ice thickness changed. Partially-filled neighbors of these cells
+  // have to be checked in step 2.
+  auto update_geometry = [&]() {
+    for (size_t k = 0; k < halo.size(); ++k) {
+      halo_thickness[k] = ice_thickness(halo[k].i, halo[k].j);
+    }
+
+    ice_thickness.update_ghosts();
+
+    for (size_t k = 0; k < halo.size(); ++k) {
+      if (ice_thickness(halo[k].i, halo[k].j) != halo_thickness[k]) {
+        changed.push_back(halo[k]);
       }
+    }
+
+    for (const auto &c : changed) {
+      const int i = c.i, j = c.j;
+
+      double
+        sl = sea_level(i, j),
+        b  = bed_topography(i, j),
+        H  = ice_thickness(i, j);
+
+      cell_type(i, j)             = m_impl->gc.mask(sl, b, H);
+      ice_surface_elevation(i, j) = m_impl->gc.surface(sl, b, H);
+
+      add_candidate(i, j);
+      add_candidate(i + 1, j);
+      add_candidate(i - 1, j);
+      add_candidate(i, j + 1);
+      add_candidate(i, j - 1);
+    }
+    changed.clear();
+  };
+
+  // The first iteration checks all partially-filled cells.
+  for (auto p = m_grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    add_candidate(i, j);
+
+    if (residual(i, j) > 0.0) {
+      active.push_back({i, j});
+    }
+  }
+
+  int n_visited = 0;
+  int iteration = 0;
+  bool done     = false;
+  for (iteration = 0; iteration < max_n_iterations and not done; ++iteration) {
+    m_log->message(4, "redistribution iteration %d\n", iteration);
+
+    // First step: distribute residual mass
+    for (const auto &c : active) {
+      const int i = c.i, j = c.j;
 
       auto m = cell_type.star(i, j);
 
@@ -860,82 +1111,133 @@ void GeometryEvolution::residual_redistribution_iteration(const array::Scalar &b
         // front
         ice_thickness(i, j) += residual(i, j);
         residual(i, j) = 0.0;
+        changed.push_back(c);
       }
     }
 
     residual.update_ghosts();
 
-    // update area_specific_volume using adjusted residuals
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j();
+    // find ice-free ocean cells next to cells with positive residual (including ghosts)
+    {
+      auto add_receivers = [&](const Cell &c) {
+        if (not (residual(c.i, c.j) > 0.0)) {
+          return;
+        }
+        for (auto n : { Cell{ c.i + 1, c.j }, Cell{ c.i - 1, c.j }, Cell{ c.i, c.j + 1 },
+                        Cell{ c.i, c.j - 1 } }) {
+          if (owned(n.i, n.j) and cell_type.ice_free_ocean(n.i, n.j) and
+              not is_receiver[index(n.i, n.j)]) {
+            is_receiver[index(n.i, n.j)] = true;
+            receivers.push_back(n);
+          }
+        }
+      };
 
-      if (cell_type.ice_free_ocean(i, j)) {
-        area_specific_volume(i, j) +=
-            (residual(i + 1, j) + residual(i - 1, j) + residual(i, j + 1) + residual(i, j - 1));
+      for (const auto &c : active) {
+        add_receivers(c);
+      }
+      for (const auto &c : halo) {
+        add_receivers(c);
       }
     }
 
-    residual.set(0.0);
-  }
+    // update area_specific_volume using adjusted residuals
+    for (const auto &c : receivers) {
+      const int i = c.i, j = c.j;
 
-  ice_thickness.update_ghosts();
+      area_specific_volume(i, j) +=
+          (residual(i + 1, j) + residual(i - 1, j) + residual(i, j + 1) + residual(i, j - 1));
 
-  // Store ice thickness. We need this copy to make sure that modifying ice_thickness in the loop
-  // below does not affect the computation of the threshold thickness. (Note that
-  // part_grid_threshold_thickness uses neighboring values of the mask, ice thickness, and surface
-  // elevation.)
-  m_impl->thickness.copy_from(ice_thickness);
+      is_receiver[index(i, j)] = false;
+      add_candidate(i, j);
+    }
 
-  // The loop above updated ice_thickness, so we need to re-calculate the mask and the
-  // surface elevation:
-  m_impl->gc.compute(sea_level, bed_topography, ice_thickness, cell_type, ice_surface_elevation);
+    // reset residuals (including ghosts)
+    for (const auto &c : active) {
+      residual(c.i, c.j) = 0.0;
+    }
+    for (const auto &c : halo) {
+      residual(c.i, c.j) = 0.0;
+    }
 
-  double remaining_residual = 0.0;
+    n_visited += (int)(active.size() + receivers.size());
+    active.clear();
+    receivers.clear();
+
+    // The loop above updated ice_thickness, so we need to re-calculate the mask and the
+    // surface elevation:
+    update_geometry();
+
+    // Second step: we need to redistribute residual ice volume if
+    // neighbors which gained redistributed ice also become full.
+    double remaining_residual = 0.0;
+    {
+      // Compute all thresholds first to make sure that modifying ice_thickness below does
+      // not affect them. (Note that part_grid_threshold_thickness uses neighboring values
+      // of the mask, ice thickness, and surface elevation.)
+      std::vector<double> thresholds(candidates.size());
+      for (size_t k = 0; k < candidates.size(); ++k) {
+        const int i = candidates[k].i, j = candidates[k].j;
+
+        stencils::Star<double> H;
+        H.c = ice_thickness(i, j);
+        H.e = ice_thickness(i + 1, j);
+        H.w = ice_thickness(i - 1, j);
+        H.n = ice_thickness(i, j + 1);
+        H.s = ice_thickness(i, j - 1);
+
+        thresholds[k] = part_grid_threshold_thickness(cell_type.star_int(i, j), H,
+                                                      ice_surface_elevation.star(i, j),
+                                                      bed_topography(i, j));
+      }
 
-  // Second step: we need to redistribute residual ice volume if
-  // neighbors which gained redistributed ice also become full.
-  {
-    // will be destroyed at the end of the block
-    array::AccessScope list{ &m_impl->thickness, &ice_thickness, &ice_surface_elevation,
-                             &bed_topography, &cell_type };
+      for (size_t k = 0; k < candidates.size(); ++k) {
+        const int i = candidates[k].i, j = candidates[k].j;
 
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j();
+        is_candidate[index(i, j)] = false;
 
-      if (area_specific_volume(i, j) <= 0.0) {
-        continue;
-      }
+        if (area_specific_volume(i, j) <= 0.0) {
+          continue;
+        }
 
-      double threshold =
-          part_grid_threshold_thickness(cell_type.star_int(i, j), m_impl->thickness.star(i, j),
-                                        ice_surface_elevation.star(i, j), bed_topography(i, j));
+        double threshold = thresholds[k];
 
-      // if threshold is zero, turn all the area specific volume into ice thickness, with zero
-      // residual
-      if (threshold == 0.0) {
-        threshold = area_specific_volume(i, j);
-      }
+        // if threshold is zero, turn all the area specific volume into ice thickness, with
+        // zero residual
+        if (threshold == 0.0) {
+          threshold = area_specific_volume(i, j);
+        }
 
-      if (area_specific_volume(i, j) >= threshold) {
-        ice_thickness(i, j) += threshold;
-        residual(i, j)             = area_specific_volume(i, j) - threshold;
-        area_specific_volume(i, j) = 0.0;
+        if (area_specific_volume(i, j) >= threshold) {
+          ice_thickness(i, j) += threshold;
+          residual(i, j)             = area_specific_volume(i, j) - threshold;
+          area_specific_volume(i, j) = 0.0;
 
-        remaining_residual += residual(i, j);
+          remaining_residual += residual(i, j);
+
+          changed.push_back(candidates[k]);
+          if (residual(i, j) > 0.0) {
+            active.push_back(candidates[k]);
+          }
+        }
       }
+
+      n_visited += (int)candidates.size();
+      candidates.clear();
     }
-  }
 
-  // check if redistribution should be run once more
-  remaining_residual = GlobalSum(m_grid->com, remaining_residual);
+    update_geometry();
+
+    // check if redistribution should be run once more
+    remaining_residual = GlobalSum(m_grid->com, remaining_residual);
 
-  if (remaining_residual > 0.0) {
-    done = false;
-  } else {
-    done = true;
+    done = not (remaining_residual > 0.0);
   }
 
-  ice_thickness.update_ghosts();
+  m_log->message(3, "  part-grid residual redistribution: %d iterations, %d cells visited\n",
+                 iteration, GlobalSum(m_grid->com, n_visited));
+
+  return done;
 }
 
 /*!
@@ -84,14 +84,14 @@ protected:
                        array::Scalar& ice_thickness,
                        array::Scalar& area_specific_volume);
 
-  void residual_redistribution_iteration(const array::Scalar &bed_topography,
-                                         const array::Scalar &sea_level,
-                                         array::Scalar1      &ice_surface_elevation,
-                                         array::Scalar       &ice_thickness,
-                                         array::CellType1    &cell_type,
-                                         array::Scalar       &Href,
-                                         array::Scalar       &H_residual,
-                                         bool                &done);
+  bool residual_redistribution(int max_n_iterations,
+                               const array::Scalar &bed_topography,
+                               const array::Scalar &sea_level,
+                               array::Scalar1      &ice_surface_elevation,
+                               array::Scalar       &ice_thickness,
+                               array::CellType1    &cell_type,
+                               array::Scalar       &Href,
+                               array::Scalar1      &H_residual);
 
   virtual void compute_interface_fluxes(const array::CellType1 &cell_type,
                                         const array::Scalar        &ice_thickness,
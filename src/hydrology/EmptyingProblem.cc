@@ -17,9 +17,13 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>            // std::sort
+#include <vector>
+
 #include "pism/hydrology/EmptyingProblem.hh"
 
 #include "pism/geometry/Geometry.hh"
+#include "pism/util/fill_depressions.hh"
 #include "pism/util/interpolation.hh"
 #include "pism/util/pism_utilities.hh"
 
@@ -248,6 +252,18 @@ void EmptyingProblem::update(const Geometry &geometry,
     return;
   }
 
+  if (m_config->get_string("hydrology.steady.method") == "flow_accumulation") {
+    // updates ghosts of m_Qsum
+    accumulate_flow(geometry.cell_type, water_input_rate);
+
+    staggered_to_regular(geometry.cell_type, m_Qsum,
+                         true,    // include floating ice
+                         m_Q);
+
+    diagnostics::effective_water_velocity(geometry, m_Q, m_q_sg);
+    return;
+  }
+
   double volume = 0.0;
   int step_counter = 0;
 
@@ -312,6 +328,129 @@ void EmptyingProblem::update(const Geometry &geometry,
   diagnostics::effective_water_velocity(geometry, m_Q, m_q_sg);
 }
 
+/*!
+ * Compute the steady state water flux by solving the steady state transport problem
+ * directly.
+ *
+ * The iteration in update() accumulates fluxes while the water input drains. Once all the
+ * water is gone the time-integrated water thickness `F` satisfies `div(V F) = W_0`, so the
+ * flux `V F / tau` can be computed by solving
+ *
+ * `div(V G) = M`
+ *
+ * for `G` (here `M` is the water input rate), using the same upwinding.
+ *
+ * Water flows from higher to lower values of the hydraulic potential, so the flow graph
+ * has no cycles and ordering cells by decreasing potential makes the upwind
+ * discretization of this problem triangular. Each process solves its part of the problem
+ * exactly in one sweep, using values at ghost points computed during the previous sweep.
+ * The number of sweeps is one plus the number of times the longest flow path crosses
+ * sub-domain boundaries.
+ *
+ * Water reaching a cell without outflow (a sink) stays there; it is reported in
+ * remaining_water_thickness().
+ *
+ * Uses m_W as temporary storage with ghosts. Sets m_Qsum (including ghosts) and m_W.
+ */
+void EmptyingProblem::accumulate_flow(const array::CellType &cell_type,
+                                      const array::Scalar &water_input_rate) {
+
+  const int n_iterations = m_config->get_number("hydrology.steady.n_iterations");
+
+  array::Scalar1 &G = m_W;
+
+  array::AccessScope list{&cell_type, &water_input_rate, &m_Vstag, &m_domain_mask,
+                          &m_potential, &G, &m_Qsum, &m_tmp};
+
+  // owned cells in the domain, sorted by decreasing potential
+  std::vector<std::pair<double, int> > order;
+  {
+    const int xs = m_grid->xs(), ys = m_grid->ys(), xm = m_grid->xm();
+
+    for (auto p = m_grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      if (m_domain_mask(i, j) > 0.5) {
+        order.emplace_back(m_potential(i, j), (j - ys) * xm + (i - xs));
+      }
+    }
+
+    std::sort(order.begin(), order.end(),
+              [](const std::pair<double, int> &a, const std::pair<double, int> &b) {
+                return a.first > b.first;
+              });
+  }
+
+  // Outflow and inflow rates of a cell. Outside the domain G is zero, so water leaving the
+  // domain is lost.
+  auto outflow = [this](const stencils::Star<double> &v) {
+    return (std::max(v.e, 0.0) + std::max(-v.w, 0.0)) / m_dx +
+           (std::max(v.n, 0.0) + std::max(-v.s, 0.0)) / m_dy;
+  };
+  auto inflow = [this](const stencils::Star<double> &v, const stencils::Star<double> &g) {
+    return (std::max(v.w, 0.0) * g.w + std::max(-v.e, 0.0) * g.e) / m_dx +
+           (std::max(v.s, 0.0) * g.s + std::max(-v.n, 0.0) * g.n) / m_dy;
+  };
+
+  G.set(0.0);
+
+  int step_counter = 0;
+  for (step_counter = 0; step_counter < n_iterations; ++step_counter) {
+    const int xs = m_grid->xs(), ys = m_grid->ys(), xm = m_grid->xm();
+
+    int n_changed = 0;
+    for (const auto &cell : order) {
+      const int i = xs + cell.second % xm, j = ys + cell.second / xm;
+
+      auto v = m_Vstag.star(i, j);
+
+      double
+        source  = cell_type.icy(i, j) ? water_input_rate(i, j) : 0.0,
+        out     = outflow(v),
+        G_new   = out > 0.0 ? (source + inflow(v, G.star(i, j))) / out : 0.0;
+
+      if (G_new != G(i, j)) {
+        n_changed += 1;
+        G(i, j) = G_new;
+      }
+    }
+    G.update_ghosts();
+
+    if (GlobalSum(m_grid->com, n_changed) == 0) {
+      break;
+    }
+  }
+
+  if (step_counter == n_iterations) {
+    m_log->message(2, "WARNING: flow accumulation did not converge after %d sweeps.\n",
+                   n_iterations);
+  } else {
+    m_log->message(3, "Emptying problem: flow accumulation converged after %d sweeps.\n",
+                   step_counter + 1);
+  }
+
+  // compute fluxes and water trapped in sinks
+  for (auto p = m_grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    auto v = m_Vstag.star(i, j);
+    auto g = G.star(i, j);
+
+    m_Qsum(i, j, 0) = v.e * (v.e >= 0.0 ? g.c : g.e);
+    m_Qsum(i, j, 1) = v.n * (v.n >= 0.0 ? g.c : g.n);
+
+    if (m_domain_mask(i, j) > 0.5 and not (outflow(v) > 0.0)) {
+      double source = cell_type.icy(i, j) ? water_input_rate(i, j) : 0.0;
+      m_tmp(i, j) = m_tau * (source + inflow(v, g));
+    } else {
+      m_tmp(i, j) = 0.0;
+    }
+  }
+  m_Qsum.update_ghosts();
+
+  m_W.copy_from(m_tmp);
+}
+
 /*! Compute the unmodified hydraulic potential (with sinks).
  *
  * @param[in] H ice thickness
@@ -338,70 +477,22 @@ void EmptyingProblem::compute_raw_potential(const array::Scalar &H,
 }
 
 /*!
- * FIXME: uses "result" as temporary storage with ghosts.
+ * Compute the hydraulic potential with depressions filled (see `fill_depressions()`).
+ *
+ * Cells outside the domain (where `domain_mask` is zero) are outlets.
  */
 void EmptyingProblem::compute_potential(const array::Scalar &ice_thickness,
                                         const array::Scalar &ice_bottom_surface,
                                         const array::Scalar &domain_mask,
                                         array::Scalar1 &result) {
-  array::Scalar &psi_new = m_tmp;
-
   double delta = m_config->get_number("hydrology.steady.potential_delta");
 
-  int n_iterations = m_config->get_number("hydrology.steady.potential_n_iterations");
-  int step_counter = 0;
-  int n_sinks = 0;
-  int n_sinks_remaining = 0;
-
   compute_raw_potential(ice_thickness, ice_bottom_surface, result);
 
-  array::AccessScope list{&result, &psi_new, &domain_mask};
-  for (step_counter = 0; step_counter < n_iterations; ++step_counter) {
-
-    n_sinks_remaining = 0;
-    for (auto p = m_grid->points(); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      if (domain_mask(i, j) > 0.5) {
-        auto P = result.star(i, j);
-
-        double
-          v_n = - (P.n - P.c),
-          v_e = - (P.e - P.c),
-          v_s = - (P.c - P.s),
-          v_w = - (P.c - P.w);
-
-        if (v_e <= 0.0 and v_w >= 0.0 and v_n <= 0.0 and v_s >= 0.0) {
-          ++n_sinks_remaining;
-
-          psi_new(i, j) = 0.25 * (P.n + P.e + P.s + P.w) + delta;
-        } else {
-          psi_new(i, j) = result(i, j);
-        }
-      } else {
-        psi_new(i, j) = result(i, j);
-      }
-    }
-    // this call updates ghosts of result
-    result.copy_from(psi_new);
-
-    n_sinks_remaining = GlobalSum(m_grid->com, n_sinks_remaining);
-
-    // remember the original number of sinks
-    if (step_counter == 0) {
-      n_sinks = n_sinks_remaining;
-    }
+  int n_sweeps = fill_depressions(domain_mask, delta, result);
 
-    if (n_sinks_remaining == 0) {
-      m_log->message(3, "Emptying problem: filled %d sinks after %d iterations.\n",
-                     n_sinks - n_sinks_remaining, step_counter);
-      break;
-    }
-  } // end of loop over step_counter
-
-  if (n_sinks_remaining > 0) {
-    m_log->message(2, "WARNING: %d sinks left.\n", n_sinks_remaining);
-  }
+  m_log->message(3, "Emptying problem: filled depressions in the hydraulic potential (%d sweeps).\n",
+                 n_sweeps);
 }
 
 
@@ -70,6 +70,9 @@ protected:
                     const array::Scalar *no_model_mask,
                     array::Scalar &result) const;
 
+  void accumulate_flow(const array::CellType &cell_type,
+                       const array::Scalar &water_input_rate);
+
   array::Scalar1 m_potential;
   array::Scalar m_tmp;
   array::Scalar m_bottom_surface;
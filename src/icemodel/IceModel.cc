@@ -61,6 +61,7 @@ IceModel::IceModel(std::shared_ptr<Grid> grid, const std::shared_ptr<Context> &c
       m_log(context->log()),
       m_time(context->time()),
       m_wide_stencil(static_cast<int>(m_config->get_number("grid.max_stencil_width"))),
+      m_timestepping(m_config),
       m_output_global_attributes("PISM_GLOBAL", m_sys),
       m_geometry(m_grid),
       m_new_bed_elevation(true),
@@ -661,7 +662,7 @@ void IceModel::step(bool do_mass_continuity,
     m_new_bed_elevation = false;
   }
 
-  if (m_config->get_flag("time_stepping.assume_bed_elevation_changed")) {
+  if (m_timestepping.assume_bed_elevation_changed.value()) {
     m_new_bed_elevation = true;
   }
 
@@ -817,7 +818,7 @@ IceModelTerminationReason IceModel::run() {
     bool updateAtDepth = m_skip_countdown == 0;
     bool tempAgeStep   = updateAtDepth and (m_age_model or do_energy);
 
-    double time_resolution = m_config->get_number("time_stepping.resolution");
+    double time_resolution = m_timestepping.resolution.value();
     const bool show_step = tempAgeStep or fabs(m_time->current() - m_time->end()) < time_resolution;
     print_summary(show_step);
 
@@ -252,6 +252,21 @@ protected:
 
   const int m_wide_stencil;
 
+  //! Parameters used every time step
+  struct TimesteppingParameters {
+    TimesteppingParameters(Config::ConstPtr config);
+
+    ConfigNumber adaptive_ratio;
+    ConfigNumber maximum_time_step;
+    ConfigNumber resolution;
+    ConfigNumber hit_multiples;
+    ConfigNumber skip_max;
+    ConfigFlag skip;
+    ConfigFlag assume_bed_elevation_changed;
+    ConfigFlag front_retreat_use_cfl;
+    ConfigFlag update_geometry;
+  } m_timestepping;
+
   //! stores global attributes saved in a PISM output file
   VariableMetadata m_output_global_attributes;
 
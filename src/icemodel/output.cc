@@ -19,6 +19,7 @@
 #include <gsl/gsl_interp.h>     // gsl_interp_bsearch()
 
 #include <algorithm>
+#include <map>
 #include <set>
 
 #include "pism/icemodel/IceModel.hh"
@@ -34,6 +35,7 @@
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/projection.hh"
 #include "pism/util/Component.hh"
+#include "pism/util/error_handling.hh"
 
 
 namespace pism {
@@ -249,15 +251,58 @@ void IceModel::save_variables(const File &file,
   }
 }
 
+/*!
+ * Parse `output.quantization.variables` and return the number of significant digits to
+ * keep for each diagnostic in `variables` (0 means "no quantization").
+ *
+ * Model state variables are never quantized.
+ */
+static std::map<std::string, int> quantization_digits(const Config &config,
+                                                      const std::set<std::string> &variables) {
+  int default_digits = static_cast<int>(config.get_number("output.quantization.digits"));
+
+  std::map<std::string, int> result;
+
+  auto list = config.get_string("output.quantization.variables");
+  if (list.empty()) {
+    for (const auto &v : variables) {
+      result[v] = default_digits;
+    }
+    return result;
+  }
+
+  for (const auto &entry : split(list, ',')) {
+    auto words = split(entry, ':');
+
+    if (words.size() == 1) {
+      result[words[0]] = default_digits;
+    } else if (words.size() == 2) {
+      result[words[0]] = static_cast<int>(parse_integer(words[1]));
+    } else {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "invalid entry '%s' in output.quantization.variables",
+                                    entry.c_str());
+    }
+  }
+
+  return result;
+}
+
 void IceModel::define_diagnostics(const File &file, const std::set<std::string> &variables,
                                   io::Type default_type) const {
+  auto digits = quantization_digits(*m_config, variables);
+
   for (const auto& variable : variables) {
     auto diag = m_diagnostics.find(variable);
 
     if (diag != m_diagnostics.end()) {
+      auto d = digits.find(variable);
+      file.set_quantization(d != digits.end() ? d->second : 0);
+
       diag->second->define(file, default_type);
     }
   }
+  file.set_quantization(0);
 }
 
 //! \brief Writes variables listed in vars to filename, using nctype to write
@@ -37,6 +37,19 @@
 
 namespace pism {
 
+IceModel::TimesteppingParameters::TimesteppingParameters(Config::ConstPtr config)
+    : adaptive_ratio(config, "time_stepping.adaptive_ratio"),
+      maximum_time_step(config, "time_stepping.maximum_time_step", "seconds"),
+      resolution(config, "time_stepping.resolution", "seconds"),
+      hit_multiples(config, "time_stepping.hit_multiples"),
+      skip_max(config, "time_stepping.skip.max"),
+      skip(config, "time_stepping.skip.enabled"),
+      assume_bed_elevation_changed(config, "time_stepping.assume_bed_elevation_changed"),
+      front_retreat_use_cfl(config, "geometry.front_retreat.use_cfl"),
+      update_geometry(config, "geometry.update.enabled") {
+  // empty
+}
+
 //! Compute the maximum time step allowed by the diffusive SIA.
 /*!
 If maximum diffusivity is positive (i.e. if there is diffusion going on) then
@@ -51,12 +64,11 @@ MaxTimestep IceModel::max_timestep_diffusivity() {
   double D_max = m_stress_balance->max_diffusivity();
 
   double dx = m_grid->dx(), dy = m_grid->dy(),
-         adaptive_timestepping_ratio = m_config->get_number("time_stepping.adaptive_ratio");
+         adaptive_timestepping_ratio = m_timestepping.adaptive_ratio.value();
 
   auto dt_diffusivity = ::pism::max_timestep_diffusivity(D_max, dx, dy, adaptive_timestepping_ratio);
 
-  MaxTimestep dt_max(m_config->get_number("time_stepping.maximum_time_step", "seconds"),
-                     "max time step");
+  MaxTimestep dt_max(m_timestepping.maximum_time_step.value(), "max time step");
 
   return std::min(dt_diffusivity, dt_max);
 }
@@ -74,11 +86,11 @@ MaxTimestep IceModel::max_timestep_diffusivity() {
  */
 unsigned int IceModel::skip_counter(double dt, double dt_diffusivity) {
 
-  if (not m_config->get_flag("time_stepping.skip.enabled")) {
+  if (not m_timestepping.skip.value()) {
     return 0;
   }
 
-  const int skip_max = static_cast<int>(m_config->get_number("time_stepping.skip.max"));
+  const int skip_max = static_cast<int>(m_timestepping.skip_max.value());
 
   if (dt_diffusivity > 0.0) {
     const double conservative_factor = 0.95;
@@ -104,6 +116,10 @@ IceModel::TimesteppingInfo IceModel::max_timestep(unsigned int counter) {
 
   std::vector<MaxTimestep> restrictions;
 
+  // Restrictions computed using local (sub-domain) information. All of them are combined
+  // using one global reduction below.
+  MaxTimestepReduction local_restrictions;
+
   // get time-stepping restrictions from sub-models
   for (auto m : m_submodels) {
     restrictions.push_back(m.second->max_timestep(current_time));
@@ -112,7 +128,7 @@ IceModel::TimesteppingInfo IceModel::max_timestep(unsigned int counter) {
   // mechanisms that use a retreat rate
   bool front_retreat =
       (m_eigen_calving or m_vonmises_calving or m_hayhurst_calving or m_frontal_melt);
-  if (front_retreat and m_config->get_flag("geometry.front_retreat.use_cfl")) {
+  if (front_retreat and m_timestepping.front_retreat_use_cfl.value()) {
     // at least one of front retreat mechanisms is active *and* PISM is told to use a CFL
     // restriction
 
@@ -137,15 +153,20 @@ IceModel::TimesteppingInfo IceModel::max_timestep(unsigned int counter) {
 
     assert(m_front_retreat);
 
-    restrictions.push_back(
-        m_front_retreat->max_timestep(m_geometry.cell_type, m_ice_thickness_bc_mask, retreat_rate));
+    local_restrictions.add(m_front_retreat->max_timestep_local(
+        m_geometry.cell_type, m_ice_thickness_bc_mask, retreat_rate));
+  }
+
+  local_restrictions.reduce(m_grid->com);
+  for (int k = 0; k < local_restrictions.n_restrictions(); ++k) {
+    restrictions.push_back(local_restrictions.restriction(k));
   }
 
   const char *end = "end of the run";
   const char *max = "max";
 
   // Always consider the maximum allowed time-step length.
-  double max_timestep = m_config->get_number("time_stepping.maximum_time_step", "seconds");
+  double max_timestep = m_timestepping.maximum_time_step.value();
   if (max_timestep > 0.0) {
     restrictions.push_back(MaxTimestep(max_timestep, max));
   }
@@ -164,7 +185,7 @@ IceModel::TimesteppingInfo IceModel::max_timestep(unsigned int counter) {
   }
 
   // mass continuity stability criteria
-  if (m_config->get_flag("geometry.update.enabled")) {
+  if (m_timestepping.update_geometry.value()) {
     auto cfl = m_stress_balance->max_timestep_cfl_2d();
 
     restrictions.push_back(MaxTimestep(cfl.dt_max.value(), "2D CFL"));
@@ -185,11 +206,11 @@ IceModel::TimesteppingInfo IceModel::max_timestep(unsigned int counter) {
   result.reason = (dt_max.description() + " (overrides " + dt_other.description() + ")");
   result.skip_counter = 0;
 
-  double resolution = m_config->get_number("time_stepping.resolution", "seconds");
+  double resolution = m_timestepping.resolution.value();
 
   // Hit all multiples of X years, if requested.
   {
-    int year_increment = static_cast<int>(m_config->get_number("time_stepping.hit_multiples"));
+    int year_increment = static_cast<int>(m_timestepping.hit_multiples.value());
     if (year_increment > 0) {
       auto next_time = m_time->increment_date(m_timestep_hit_multiples_last_time,
                                               year_increment);
@@ -128,12 +128,15 @@ void IP_SSAHardavForwardProblem::set_design(array::Scalar &new_zeta) {
   m_design_param.convertToDesignVariable(*m_zeta, m_hardav);
 
   // Cache hardav at the quadrature points.
-  array::AccessScope list{&m_coefficients, &m_hardav};
+  {
+    array::AccessScope list{&m_coefficients, &m_hardav};
 
-  for (auto p = m_grid->points(1); p; p.next()) {
-    const int i = p.i(), j = p.j();
-    m_coefficients(i, j).hardness = m_hardav(i, j);
+    for (auto p = m_grid->points(1); p; p.next()) {
+      const int i = p.i(), j = p.j();
+      m_coefficients(i, j).hardness = m_hardav(i, j);
+    }
   }
+  cache_quad_point_values();
 
   // Flag the state jacobian as needing rebuilding.
   m_rebuild_J_state = true;
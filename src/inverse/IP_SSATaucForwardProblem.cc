@@ -132,12 +132,15 @@ void IP_SSATaucForwardProblem::set_design(array::Scalar &new_zeta) {
   m_tauc_param.convertToDesignVariable(*m_zeta, tauc);
 
   // Cache tauc at the quadrature points.
-  array::AccessScope list{&tauc, &m_coefficients};
+  {
+    array::AccessScope list{&tauc, &m_coefficients};
 
-  for (auto p = m_grid->points(1); p; p.next()) {
-    const int i = p.i(), j = p.j();
-    m_coefficients(i, j).tauc = tauc(i, j);
+    for (auto p = m_grid->points(1); p; p.next()) {
+      const int i = p.i(), j = p.j();
+      m_coefficients(i, j).tauc = tauc(i, j);
+    }
   }
+  cache_quad_point_values();
 
   // Flag the state jacobian as needing rebuilding.
   m_rebuild_J_state = true;
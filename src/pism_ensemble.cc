@@ -0,0 +1,378 @@
+// Copyright (C) 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "Ensemble driver: runs many small PISM simulations inside one MPI job.\n";
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <petscsys.h>           // PETSC_COMM_WORLD
+
+#include "pism/icemodel/IceModel.hh"
+#include "pism/util/Config.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/Context.hh"
+#include "pism/util/EnthalpyConverter.hh"
+#include "pism/util/Logger.hh"
+#include "pism/util/Time.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/petscwrappers/PetscInitializer.hh"
+#include "pism/util/pism_options.hh"
+#include "pism/util/pism_utilities.hh"
+
+#include "pism/regional/Grid_Regional.hh"
+#include "pism/regional/IceRegionalModel.hh"
+
+using namespace pism;
+
+//! Configuration parameters that differ from the common configuration in one ensemble member.
+typedef std::map<std::string, std::string> Overrides;
+
+/*!
+ * Read the list of ensemble members from `filename`.
+ *
+ * Each non-empty line that does not start with "#" describes one member and contains a
+ * space-separated list of `parameter=value` pairs.
+ */
+static std::vector<Overrides> read_members(MPI_Comm com, const std::string &filename) {
+  int rank = 0;
+  MPI_Comm_rank(com, &rank);
+
+  // read the file on rank 0 and broadcast its contents
+  std::string contents;
+  {
+    int length = 0;
+    if (rank == 0) {
+      std::ifstream input(filename);
+      if (input.good()) {
+        std::stringstream buffer;
+        buffer << input.rdbuf();
+        contents = buffer.str();
+        length   = static_cast<int>(contents.size());
+      } else {
+        length = -1;
+      }
+    }
+    MPI_Bcast(&length, 1, MPI_INT, 0, com);
+
+    if (length < 0) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION, "failed to open '%s'",
+                                    filename.c_str());
+    }
+
+    contents.resize(length);
+    MPI_Bcast(&contents[0], length, MPI_CHAR, 0, com);
+  }
+
+  std::vector<Overrides> result;
+
+  std::istringstream lines(contents);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream tokens(line);
+
+    Overrides member;
+    std::string token;
+    while (tokens >> token) {
+      if (token[0] == '#') {
+        break;
+      }
+
+      auto k = token.find('=');
+      if (k == std::string::npos or k == 0) {
+        throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                      "invalid ensemble member description '%s' in '%s'"
+                                      " (expected parameter=value)",
+                                      token.c_str(), filename.c_str());
+      }
+      member[token.substr(0, k)] = token.substr(k + 1);
+    }
+
+    if (not member.empty()) {
+      result.emplace_back(member);
+    }
+  }
+
+  return result;
+}
+
+//! Set a configuration parameter `name` using a string `value`, checking its type.
+static void set_parameter(Config &config, const std::string &name, const std::string &value) {
+  if (not config.is_set(name)) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "unrecognized parameter %s",
+                                  name.c_str());
+  }
+
+  std::string type = config.type(name);
+
+  if (type == "string") {
+    config.set_string(name, value, CONFIG_USER);
+  } else if (type == "keyword") {
+    if (not member(value, set_split(config.choices(name), ','))) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "invalid %s value: '%s' (choices: %s)",
+                                    name.c_str(), value.c_str(), config.choices(name).c_str());
+    }
+    config.set_string(name, value, CONFIG_USER);
+  } else if (type == "flag") {
+    if (member(value, {"true", "on", "yes"})) {
+      config.set_flag(name, true, CONFIG_USER);
+    } else if (member(value, {"false", "off", "no"})) {
+      config.set_flag(name, false, CONFIG_USER);
+    } else {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION, "invalid %s value: '%s'",
+                                    name.c_str(), value.c_str());
+    }
+  } else if (type == "number") {
+    config.set_number(name, parse_number(value), CONFIG_USER);
+  } else if (type == "integer") {
+    config.set_number(name, (double)parse_integer(value), CONFIG_USER);
+  } else {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "parameter type \"%s\" is invalid",
+                                  type.c_str());
+  }
+}
+
+//! Add the index of an ensemble member to a file name, e.g. "output.nc" -> "output_3.nc".
+static std::string member_filename(const std::string &filename, int index) {
+  auto suffix = filename.rfind(".nc");
+  if (suffix != std::string::npos and suffix + 3 == filename.size()) {
+    return pism::printf("%s_%d.nc", filename.substr(0, suffix).c_str(), index);
+  }
+  return pism::printf("%s_%d", filename.c_str(), index);
+}
+
+/*!
+ * Create the configuration database of an ensemble member.
+ *
+ * Copies parameters from `base` (i.e. the configuration file, -config_override and
+ * command-line options are processed only once per job) and then applies member-specific
+ * `overrides`. Output file names that are not set explicitly get the member index as a
+ * suffix.
+ */
+static Config::Ptr member_config(MPI_Comm com, const NetCDFConfig &base,
+                                 units::System::Ptr sys, const Overrides &overrides,
+                                 int index) {
+  auto config = std::make_shared<DefaultConfig>(com, "pism_config", "-config", sys);
+  config->copy_from(base);
+
+  for (const auto &p : overrides) {
+    set_parameter(*config, p.first, p.second);
+  }
+
+  for (const auto *name : { "output.file", "output.extra.file", "output.timeseries.filename",
+                            "output.snapshot.file", "output.checkpoint.file" }) {
+    auto filename = config->get_string(name, Config::FORGET_THIS_USE);
+    if (not filename.empty() and overrides.find(name) == overrides.end()) {
+      config->set_string(name, member_filename(filename, index));
+    }
+  }
+
+  config->resolve_filenames();
+
+  return config;
+}
+
+/*!
+ * Run one ensemble member using the communicator `com`.
+ *
+ * Returns `true` on success.
+ */
+static bool run_member(MPI_Comm com, const NetCDFConfig &base, units::System::Ptr sys,
+                       const Overrides &overrides, int index, bool regional) {
+  try {
+    auto logger = logger_from_options(com);
+    auto config = member_config(com, base, sys, overrides, index);
+    auto time   = std::make_shared<Time>(com, config, *logger, sys);
+
+    std::shared_ptr<EnthalpyConverter> EC(new EnthalpyConverter(*config));
+
+    auto ctx = std::make_shared<Context>(com, sys, config, EC, time, logger,
+                                         "pism_ensemble");
+
+    logger->message(2, "* Starting ensemble member %d...\n", index);
+
+    std::shared_ptr<Grid> grid;
+    std::unique_ptr<IceModel> model;
+
+    if (regional) {
+      grid = regional_grid_from_options(ctx);
+      model.reset(new IceRegionalModel(grid, ctx));
+    } else {
+      grid = Grid::FromOptions(ctx);
+      model.reset(new IceModel(grid, ctx));
+    }
+
+    model->init();
+
+    if (model->run() == PISM_DONE) {
+      model->save_results();
+    }
+
+    print_unused_parameters(*logger, 3, *config);
+
+    logger->message(2, "* Ensemble member %d is done.\n", index);
+  } catch (RuntimeError &e) {
+    e.print(com);
+    return false;
+  } catch (std::exception &e) {
+    RuntimeError(PISM_ERROR_LOCATION, e.what()).print(com);
+    return false;
+  }
+  return true;
+}
+
+/*!
+ * Scheduler handing out ensemble member indexes.
+ *
+ * Uses an atomic counter stored on rank 0 of the global communicator: the leader (rank 0) of
+ * each group increments it and broadcasts the result to the rest of the group. This way
+ * groups that finish early pick up remaining members, balancing the load when members differ
+ * in cost.
+ */
+class Scheduler {
+public:
+  Scheduler(MPI_Comm world, MPI_Comm group)
+    : m_group(group), m_counter(0), m_window(MPI_WIN_NULL) {
+    int rank = 0;
+    MPI_Comm_rank(world, &rank);
+
+    MPI_Aint size = rank == 0 ? sizeof(int) : 0;
+    MPI_Win_create(&m_counter, size, sizeof(int), MPI_INFO_NULL, world, &m_window);
+  }
+
+  ~Scheduler() {
+    MPI_Win_free(&m_window);
+  }
+
+  //! Get the index of the next member to run. Collective on the group.
+  int next() {
+    int rank = 0;
+    MPI_Comm_rank(m_group, &rank);
+
+    int index = 0;
+    if (rank == 0) {
+      int one = 1;
+      MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, m_window);
+      MPI_Fetch_and_op(&one, &index, MPI_INT, 0, 0, MPI_SUM, m_window);
+      MPI_Win_unlock(0, m_window);
+    }
+    MPI_Bcast(&index, 1, MPI_INT, 0, m_group);
+
+    return index;
+  }
+private:
+  MPI_Comm m_group;
+  int m_counter;
+  MPI_Win m_window;
+};
+
+int main(int argc, char *argv[]) {
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  com = PETSC_COMM_WORLD;
+
+  int exit_code = 0;
+  try {
+    // quantities shared by all ensemble members
+    units::System::Ptr sys(new units::System);
+    auto log = logger_from_options(com);
+
+    std::string usage =
+      "  pism_ensemble -ensemble FILE [-member_size N] -i IN.nc [-bootstrap] [-regional]\n"
+      "                [OTHER PISM & PETSc OPTIONS]\n"
+      "where:\n"
+      "  -ensemble      FILE lists ensemble members, one per line, as parameter=value pairs\n"
+      "  -member_size   number of MPI processes used by each member\n"
+      "  -regional      enable \"regional mode\"\n"
+      "notes:\n"
+      "  * all options except -ensemble and -member_size apply to all members\n"
+      "  * output file names get the member index as a suffix unless set in FILE\n";
+    {
+      bool done = show_usage_check_req_opts(*log, "PISM_ENSEMBLE (ensemble run mode)",
+                                            {"-ensemble"}, usage);
+      if (done) {
+        return 0;
+      }
+    }
+
+    options::String ensemble_file("-ensemble", "File listing ensemble members");
+    options::Integer member_size("-member_size", "Number of MPI processes per ensemble member", 1);
+    bool regional = options::Bool("-regional", "enable regional (outlet glacier) mode");
+
+    int size = 0, rank = 0;
+    MPI_Comm_size(com, &size);
+    MPI_Comm_rank(com, &rank);
+
+    if (member_size <= 0 or size % member_size != 0) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "-member_size %d is invalid: the number of processes (%d)"
+                                    " has to be a multiple of it",
+                                    member_size.value(), size);
+    }
+
+    // process the configuration file, -config_override and command-line options once
+    auto base = std::dynamic_pointer_cast<NetCDFConfig>(config_from_options(com, *log, sys));
+    print_config(*log, 3, *base);
+
+    auto members = read_members(com, ensemble_file);
+    int n_members = static_cast<int>(members.size());
+
+    int n_groups = size / member_size;
+    log->message(2, "PISM ensemble: %d members, %d groups of %d processes each\n",
+                 n_members, n_groups, member_size.value());
+
+    MPI_Comm group = MPI_COMM_NULL;
+    MPI_Comm_split(com, rank / member_size, rank, &group);
+
+    int n_failed = 0;
+    {
+      Scheduler scheduler(com, group);
+
+      for (int index = scheduler.next(); index < n_members; index = scheduler.next()) {
+        if (not run_member(group, *base, sys, members[index], index, regional)) {
+          n_failed += 1;
+        }
+      }
+    }
+
+    MPI_Comm_free(&group);
+
+    // count failures on leaders only: group members agree on the outcome
+    int leader_failed = (rank % member_size == 0) ? n_failed : 0;
+    int total_failed  = 0;
+    MPI_Allreduce(&leader_failed, &total_failed, 1, MPI_INT, MPI_SUM, com);
+
+    if (total_failed > 0) {
+      log->message(1, "PISM ensemble: %d of %d members failed\n", total_failed, n_members);
+      exit_code = 1;
+    } else {
+      log->message(2, "PISM ensemble: done with %d members\n", n_members);
+    }
+  }
+  catch (...) {
+    handle_fatal_errors(com);
+    exit_code = 1;
+  }
+
+  return exit_code;
+}
@@ -1,8 +1,12 @@
 %{
 #include "age/AgeModel.hh"
 #include "age/AgeColumnSystem.hh"
+#include "age/Isochrones.hh"
 %}
 
 %shared_ptr(pism::AgeModel)
 %include "age/AgeModel.hh"
 %include "age/AgeColumnSystem.hh"
+
+%shared_ptr(pism::Isochrones)
+%include "age/Isochrones.hh"
@@ -61,6 +61,7 @@
 #include "energy/bootstrapping.hh"
 #include "util/node_types.hh"
 
+#include "util/fill_depressions.hh"
 #include "util/label_components.hh"
 %}
 
@@ -376,6 +377,7 @@ pism_class(pism::Poisson, "pism/util/Poisson.hh")
 #endif
 
 pism_class(pism::FractureDensity, "pism/fracturedensity/FractureDensity.hh")
+%include "util/fill_depressions.hh"
 %include "util/label_components.hh"
 
 pism_class(pism::IceModel, "pism/icemodel/IceModel.hh")
@@ -38,3 +38,8 @@ pism_class(pism::calving::IcebergRemover,
 
 pism_class(pism::calving::IcebergRemoverFEM,
            "pism/frontretreat/util/IcebergRemoverFEM.hh")
+
+%rename(FrontIndexPoint) pism::FrontIndex::Point;
+pism_class(pism::FrontIndex,
+           "pism/frontretreat/util/FrontIndex.hh")
+%template(FrontIndexPoints) std::vector<pism::FrontIndex::Point>;
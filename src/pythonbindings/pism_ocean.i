@@ -69,7 +69,43 @@
 
 %shared_ptr(pism::ocean::GivenTH)
 %rename(OceanGivenTH) pism::ocean::GivenTH;
+%rename(GivenTHConstants) pism::ocean::GivenTH::Constants;
+%ignore pism::ocean::GivenTH::pointwise_update;
+%ignore pism::ocean::GivenTH::batch_update;
 %include "coupler/ocean/GivenTH.hh"
+// Wrappers of pointwise_update() and batch_update() processing all cells in given
+// arrays. Both return shelf base temperatures followed by shelf base melt rates.
+%extend pism::ocean::GivenTH
+{
+  static std::vector<double> pointwise_update_cells(const pism::ocean::GivenTH::Constants &c,
+                                                    const std::vector<double> &salinity,
+                                                    const std::vector<double> &theta,
+                                                    const std::vector<double> &thickness) {
+    size_t n = salinity.size();
+    assert(theta.size() == n and thickness.size() == n);
+    std::vector<double> result(2 * n);
+    for (size_t k = 0; k < n; ++k) {
+      pism::ocean::GivenTH::pointwise_update(c, salinity[k], theta[k], thickness[k],
+                                             &result[k], &result[n + k]);
+    }
+    return result;
+  }
+
+  static std::vector<double> batch_update_cells(const pism::ocean::GivenTH::Constants &c,
+                                                const std::vector<double> &salinity,
+                                                const std::vector<double> &theta,
+                                                const std::vector<double> &thickness) {
+    int n = salinity.size(), N = pism::ocean::GivenTH::batch_size;
+    assert(theta.size() == (size_t)n and thickness.size() == (size_t)n);
+    std::vector<double> result(2 * n);
+    for (int k = 0; k < n; k += N) {
+      pism::ocean::GivenTH::batch_update(c, std::min(N, n - k),
+                                         &salinity[k], &theta[k], &thickness[k],
+                                         &result[k], &result[n + k]);
+    }
+    return result;
+  }
+};
 
 %shared_ptr(pism::ocean::Pico)
 %rename(OceanPico) pism::ocean::Pico;
@@ -48,6 +48,9 @@ SSB_Modifier::SSB_Modifier(std::shared_ptr<const Grid> g)
       .output_units("m year-1")
       .standard_name("land_ice_y_velocity");
 
+  m_u.enable_compression();
+  m_v.enable_compression();
+
   m_diffusive_flux.metadata(0)
       .long_name("diffusive (SIA) flux components on the staggered grid")
       .units("m2 s-1");
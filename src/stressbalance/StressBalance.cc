@@ -152,6 +152,9 @@ StressBalance::StressBalance(std::shared_ptr<const Grid> g,
   m_strain_heating.metadata(0)
       .long_name("rate of strain heating in ice (dissipation heating)")
       .units("W m-3");
+
+  m_w.enable_compression();
+  m_strain_heating.enable_compression();
 }
 
 StressBalance::~StressBalance() {
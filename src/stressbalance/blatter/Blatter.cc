@@ -267,12 +267,32 @@ Blatter::Blatter(std::shared_ptr<const Grid> grid, int Mz, int coarsening_factor
 
   auto pism_da = grid->get_dm(1, 0);
 
-  int ierr = setup(*pism_da, grid->periodicity(), Mz, coarsening_factor, "bp_");
+  m_matrix_free = m_config->get_flag("stress_balance.blatter.matrix_free");
+
+  int ierr = setup(*pism_da, grid->periodicity(), Mz, coarsening_factor, "bp_",
+                   m_matrix_free);
   if (ierr != 0) {
     throw RuntimeError(PISM_ERROR_LOCATION,
                        "Failed to allocate a Blatter solver instance");
   }
 
+  {
+    m_pc_reuse.enabled          = m_config->get_flag("stress_balance.blatter.reuse_preconditioner.enabled");
+    m_pc_reuse.max_ksp_ratio    = m_config->get_number("stress_balance.blatter.reuse_preconditioner.max_ksp_ratio");
+    m_pc_reuse.ksp_it_reference = 0.0;
+    m_pc_reuse.valid            = false;
+    m_pc_reuse.n_success        = 0;
+    m_pc_reuse.n_failure        = 0;
+    m_pc_reuse.n_rebuilds       = 0;
+
+    if (m_pc_reuse.enabled) {
+      // preconditioner lag set by rebuild_preconditioner() should persist across
+      // SNESSolve() calls
+      ierr = SNESSetLagPreconditionerPersists(m_snes, PETSC_TRUE);
+      PISM_CHK(ierr, "SNESSetLagPreconditionerPersists");
+    }
+  }
+
   {
     std::vector<double> sigma(Mz);
     double dz = 1.0 / (Mz - 1.0);
@@ -381,7 +401,8 @@ static PetscErrorCode blatter_coarsening_hook(DM dm_fine, DM dm_coarse, void *ct
  */
 PetscErrorCode Blatter::setup(DM pism_da, grid::Periodicity periodicity, int Mz,
                               int coarsening_factor,
-                              const std::string &prefix) {
+                              const std::string &prefix,
+                              bool matrix_free) {
   MPI_Comm comm;
   PetscErrorCode ierr = PetscObjectGetComm((PetscObject)pism_da, &comm); CHKERRQ(ierr);
 
@@ -507,6 +528,10 @@ PetscErrorCode Blatter::setup(DM pism_da, grid::Periodicity periodicity, int Mz,
                                     (DMDASNESJacobian)jacobian_callback,
                                     this); CHKERRQ(ierr);
 
+    if (matrix_free) {
+      ierr = setup_matrix_free(); CHKERRQ(ierr);
+    }
+
     ierr = SNESSetFromOptions(m_snes); CHKERRQ(ierr);
 
 
@@ -858,7 +883,9 @@ Blatter::SolutionInfo Blatter::parameter_continuation() {
     m_log->message(2, "Blatter solver: step %d with lambda = %f, eps = %e\n",
                    N, lambda, m_viscosity_eps);
 
-    // Solve the system:
+    // Solve the system (the regularization parameter changed, so a preconditioner built
+    // during the previous step is not likely to be useful):
+    rebuild_preconditioner();
 
     info = solve();
     snes_total_it += info.snes_it;
@@ -971,6 +998,27 @@ static void enable_ew(::SNES snes) {
   ierr = SNESKSPSetUseEW(snes, PETSC_TRUE); PISM_CHK(ierr, "SNESKSPSetUseEW");
 }
 
+/*!
+ * Ensure that the preconditioner is re-built during the next Newton iteration.
+ *
+ * If preconditioner reuse is enabled the preconditioner lag is -1 ("never re-build") and
+ * persists across SNESSolve() calls. Setting it to -2 re-builds it once.
+ *
+ * Does nothing if preconditioner reuse is disabled: in this case the preconditioner is
+ * re-built during every Newton iteration.
+ */
+void Blatter::rebuild_preconditioner() {
+  if (not m_pc_reuse.enabled) {
+    return;
+  }
+
+  PetscErrorCode ierr = SNESSetLagPreconditioner(m_snes, -2);
+  PISM_CHK(ierr, "SNESSetLagPreconditioner");
+
+  m_pc_reuse.valid = false;
+  m_pc_reuse.n_rebuilds += 1;
+}
+
 void Blatter::update(const Inputs &inputs, bool full_update) {
   PetscErrorCode ierr;
   (void) full_update;
@@ -989,6 +1037,8 @@ void Blatter::update(const Inputs &inputs, bool full_update) {
 
   report_mesh_info();
 
+  double start_time = get_time(m_grid->com);
+
   // Store the "old" initial guess: it may be needed to re-try.
   ierr = VecCopy(m_x, m_x_old); PISM_CHK(ierr, "VecCopy");
 
@@ -1003,6 +1053,13 @@ void Blatter::update(const Inputs &inputs, bool full_update) {
     ierr = VecNorm(m_x, NORM_INFINITY, &norm); PISM_CHK(ierr, "VecNorm");
   }
 
+  // True if the first attempt uses the preconditioner built during a previous call
+  bool reusing_pc = m_pc_reuse.enabled and m_pc_reuse.valid;
+
+  if (not reusing_pc) {
+    rebuild_preconditioner();
+  }
+
   // First attempt
   {
     if (m_ksp_use_ew and norm == 0.0) {
@@ -1020,6 +1077,48 @@ void Blatter::update(const Inputs &inputs, bool full_update) {
     ksp_total_it += info.ksp_it;
 
     if (info.snes_reason > 0) {
+      if (m_pc_reuse.enabled) {
+        double ksp_per_newton = info.ksp_it / std::max((double)info.snes_it, 1.0);
+
+        if (reusing_pc) {
+          m_pc_reuse.n_success += 1;
+
+          if (ksp_per_newton > m_pc_reuse.max_ksp_ratio * m_pc_reuse.ksp_it_reference) {
+            m_log->message(2,
+                           "Blatter solver: %3.1f KSP iterations per Newton step (%3.1f with a new preconditioner)\n"
+                           "  Re-building the preconditioner during the next solve\n",
+                           ksp_per_newton, m_pc_reuse.ksp_it_reference);
+            m_pc_reuse.valid = false;
+          }
+        } else {
+          m_pc_reuse.ksp_it_reference = ksp_per_newton;
+          m_pc_reuse.valid = true;
+        }
+      }
+      goto bp_done;
+    }
+    m_log->message(2, "Blatter solver: %s\n", SNESConvergedReasons[info.snes_reason]);
+  }
+
+  if (reusing_pc) {
+    m_pc_reuse.n_failure += 1;
+
+    m_log->message(2, "  Trying again with a new preconditioner\n");
+
+    if (not (info.snes_reason == SNES_DIVERGED_LINE_SEARCH or
+             info.snes_reason == SNES_DIVERGED_MAX_IT)) {
+      ierr = VecCopy(m_x_old, m_x); PISM_CHK(ierr, "VecCopy");
+    }
+
+    rebuild_preconditioner();
+    info = solve();
+
+    snes_total_it += info.snes_it;
+    ksp_total_it  += info.ksp_it;
+
+    if (info.snes_reason > 0) {
+      m_pc_reuse.ksp_it_reference = info.ksp_it / std::max((double)info.snes_it, 1.0);
+      m_pc_reuse.valid = true;
       goto bp_done;
     }
     m_log->message(2, "Blatter solver: %s\n", SNESConvergedReasons[info.snes_reason]);
@@ -1039,6 +1138,7 @@ void Blatter::update(const Inputs &inputs, bool full_update) {
     }
 
     {
+      rebuild_preconditioner();
       disable_ew(m_snes, ksp_rtol);
       info = solve();
       enable_ew(m_snes);
@@ -1079,6 +1179,25 @@ void Blatter::update(const Inputs &inputs, bool full_update) {
                    (int)info.mg_coarse_ksp_it);
   }
 
+  {
+    double
+      time_per_step = (get_time(m_grid->com) - start_time) / std::max(snes_total_it, 1),
+      memory        = jacobian_memory() / (1024.0 * 1024.0);
+
+    m_log->message(2,
+                   "  Time per Newton step: %f s\n"
+                   "  Jacobian storage (%s): %.1f MiB\n",
+                   time_per_step,
+                   m_matrix_free ? "matrix-free" : "assembled",
+                   memory);
+  }
+
+  if (m_pc_reuse.enabled) {
+    m_log->message(2,
+                   "  Preconditioner reuse: %d successful, %d failed, %d re-builds\n",
+                   m_pc_reuse.n_success, m_pc_reuse.n_failure, m_pc_reuse.n_rebuilds);
+  }
+
   // put basal velocity in m_velocity to use it in the next call
   get_basal_velocity(m_velocity);
 
@@ -19,10 +19,13 @@
 #ifndef PISM_BLATTER_H
 #define PISM_BLATTER_H
 
+#include <vector>
+
 #include "pism/stressbalance/ShallowStressBalance.hh"
 #include "pism/util/petscwrappers/SNES.hh"
 #include "pism/util/petscwrappers/DM.hh"
 #include "pism/util/petscwrappers/Vec.hh"
+#include "pism/util/petscwrappers/Mat.hh"
 #include "pism/util/fem/FEM.hh"
 
 namespace pism {
@@ -102,6 +105,43 @@ protected:
   // True if the Eisenstat-Walker method of adjusting linear solver tolerances is enabled.
   bool m_ksp_use_ew;
 
+  // True if the Jacobian on the finest multigrid level is not assembled (see
+  // matrix_free.cc).
+  bool m_matrix_free;
+
+  // Matrix-free Jacobian (a MATSHELL)
+  petsc::Mat m_J_mf;
+
+  // Local (ghosted) copy of the point at which the matrix-free Jacobian was computed
+  petsc::Vec m_x_linearization;
+
+  // Diagonal of the matrix-free Jacobian
+  petsc::Vec m_J_diagonal;
+
+  // Values at quadrature points used by the matrix-free Jacobian
+  std::vector<double> m_qp_data;
+
+  // Preconditioner reuse across Newton iterations and time steps (see update())
+  struct PreconditionerReuse {
+    // true if enabled
+    bool enabled;
+    // re-build the preconditioner if the number of KSP iterations per Newton step exceeds
+    // this multiple of ksp_it_reference
+    double max_ksp_ratio;
+    // number of KSP iterations per Newton step observed with a new preconditioner
+    double ksp_it_reference;
+    // true if the current preconditioner can be re-used during the next solve
+    bool valid;
+    // number of solves that succeeded and failed with a re-used preconditioner
+    int n_success;
+    int n_failure;
+    // number of times the preconditioner was re-built
+    int n_rebuilds;
+  };
+  PreconditionerReuse m_pc_reuse;
+
+  void rebuild_preconditioner();
+
   static const int m_Nq = 100;
   static const int m_n_work = 9;
 
@@ -160,6 +200,18 @@ protected:
                               const Vector2d *u_nodal,
                               double K[2 * fem::q13d::n_chi][2 * fem::q13d::n_chi]);
 
+  PetscErrorCode setup_matrix_free();
+
+  void store_linearization(const DMDALocalInfo &info, const Vector2d ***X);
+
+  void jacobian_action(Vec x, Vec y);
+
+  double jacobian_memory() const;
+
+  static PetscErrorCode jacobian_action_callback(Mat A, Vec x, Vec y);
+
+  static PetscErrorCode jacobian_diagonal_callback(Mat A, Vec d);
+
   void compute_residual(DMDALocalInfo *info, const Vector2d ***X, Vector2d ***R);
 
   void residual_dirichlet(const DMDALocalInfo &info,
@@ -210,7 +262,7 @@ protected:
 
   // Guts of the constructor. This method wraps PETSc calls to simplify error checking.
   PetscErrorCode setup(DM pism_da, grid::Periodicity p, int Mz, int coarsening_factor,
-                       const std::string &prefix);
+                       const std::string &prefix, bool matrix_free);
 
   void set_initial_guess(const array::Array3D &u_sigma, const array::Array3D &v_sigma);
 
@@ -200,8 +200,21 @@ void Blatter::compute_jacobian(DMDALocalInfo *petsc_info,
                                const Vector2d ***X, Mat A, Mat J) {
   auto info = grid_transpose(*petsc_info);
 
+  PetscErrorCode ierr;
+
+  if (m_matrix_free and A == m_J_mf.get()) {
+    // The finest multigrid level: store the data needed to compute the action of the
+    // Jacobian instead of assembling it.
+    store_linearization(info, X);
+
+    // notify the preconditioner that the operator changed
+    ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY); PISM_CHK(ierr, "MatAssemblyBegin");
+    ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY); PISM_CHK(ierr, "MatAssemblyEnd");
+    return;
+  }
+
   // Zero out the Jacobian in preparation for updating it.
-  PetscErrorCode ierr = MatZeroEntries(J);
+  ierr = MatZeroEntries(J);
   PISM_CHK(ierr, "MatZeroEntries");
 
   ierr = MatSetOption(A, MAT_SUBSET_OFF_PROC_ENTRIES, PETSC_TRUE);
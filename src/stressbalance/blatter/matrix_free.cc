@@ -0,0 +1,540 @@
+/* Copyright (C) 2023 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cassert>              // assert
+#include <cstring>              // memset
+
+#include "pism/stressbalance/blatter/Blatter.hh"
+
+#include "pism/rheology/FlowLaw.hh"
+#include "pism/util/node_types.hh"
+#include "pism/util/pism_utilities.hh" // GlobalSum()
+
+#include "pism/stressbalance/blatter/util/DataAccess.hh"
+#include "pism/stressbalance/blatter/util/grid_hierarchy.hh"    // grid_transpose(), grid_z()
+
+namespace pism {
+namespace stressbalance {
+
+/*
+ * Matrix-free Jacobian of the Blatter system on the finest multigrid level.
+ *
+ * Instead of assembling the Jacobian we store the effective viscosity, its derivative
+ * with respect to the second invariant of the strain rate and the velocity gradient at
+ * all quadrature points of all active elements when SNES asks for a Jacobian
+ * (store_linearization()). The action of the Jacobian (jacobian_action()) is computed by
+ * re-using this data.
+ *
+ * Coarse multigrid levels use assembled matrices, so the matrix-free Jacobian is meant to
+ * be used with the multigrid preconditioner ("-bp_pc_type mg"). The finest level
+ * smoother can only use the diagonal of the Jacobian, i.e. "-bp_mg_levels_pc_type jacobi"
+ * (or "none").
+ */
+
+// Number of values stored per quadrature point: eta, d(eta)/d(gamma), u_x, u_y, u_z, v_x,
+// v_y, v_z.
+static const int n_qp_values = 8;
+
+/*!
+ * Allocate the matrix-free Jacobian.
+ */
+PetscErrorCode Blatter::setup_matrix_free() {
+  PetscErrorCode ierr;
+
+  MPI_Comm comm;
+  ierr = PetscObjectGetComm((PetscObject)m_da.get(), &comm); CHKERRQ(ierr);
+
+  PetscInt n_local = 0, N = 0;
+  ierr = VecGetLocalSize(m_x, &n_local); CHKERRQ(ierr);
+  ierr = VecGetSize(m_x, &N); CHKERRQ(ierr);
+
+  ierr = MatCreateShell(comm, n_local, n_local, N, N, this, m_J_mf.rawptr()); CHKERRQ(ierr);
+
+  ierr = MatShellSetOperation(m_J_mf, MATOP_MULT,
+                              (void (*)(void))jacobian_action_callback); CHKERRQ(ierr);
+
+  ierr = MatShellSetOperation(m_J_mf, MATOP_GET_DIAGONAL,
+                              (void (*)(void))jacobian_diagonal_callback); CHKERRQ(ierr);
+
+  ierr = MatSetOption(m_J_mf, MAT_SYMMETRIC, PETSC_TRUE); CHKERRQ(ierr);
+
+  ierr = DMCreateLocalVector(m_da, m_x_linearization.rawptr()); CHKERRQ(ierr);
+
+  ierr = VecDuplicate(m_x, m_J_diagonal.rawptr()); CHKERRQ(ierr);
+
+  // Use the shell matrix both as the Jacobian and as the matrix used to build the
+  // preconditioner on the finest multigrid level. Coarser levels use matrices created
+  // by DMCreateMatrix().
+  ierr = SNESSetJacobian(m_snes, m_J_mf, m_J_mf, NULL, NULL); CHKERRQ(ierr);
+
+  return 0;
+}
+
+/*!
+ * Store values needed to compute the action of the Jacobian at the current iterate `X`.
+ *
+ * Also computes the diagonal of the Jacobian (used by the Jacobi smoother on the finest
+ * multigrid level).
+ */
+void Blatter::store_linearization(const DMDALocalInfo &info, const Vector2d ***X) {
+
+  // horizontal grid spacing is the same on all multigrid levels
+  double
+    x_min = m_grid->x0() - m_grid->Lx(),
+    y_min = m_grid->y0() - m_grid->Ly(),
+    dx    = m_grid->dx(),
+    dy    = m_grid->dy();
+
+  fem::Q1Element3 element(info,
+                          fem::Q13DQuadrature8(),
+                          dx, dy, x_min, y_min);
+
+  // Maximum number of nodes per element
+  const int Nk = fem::q13d::n_chi;
+  assert(element.n_chi() <= Nk);
+  assert(element.n_pts() <= m_Nq);
+
+  // scalar quantities
+  double z[Nk];
+  double floatation[Nk], bottom_elevation[Nk], ice_thickness[Nk];
+  double B_nodal[Nk], basal_yield_stress[Nk];
+  int node_type[Nk];
+
+  // 2D vector quantities
+  Vector2d velocity[Nk], D_nodal[Nk];
+
+  Vector2d
+    *u_x = m_work2[1],
+    *u_y = m_work2[2],
+    *u_z = m_work2[3];
+
+  double *B = m_work[0];
+
+  DataAccess<double***> hardness(info.da, 3, GHOSTED);
+
+  array::AccessScope list(m_parameters);
+  auto *P = m_parameters.array();
+
+  PetscErrorCode ierr;
+
+  // Keep a copy of the current iterate: it is used to compute contributions of the basal
+  // boundary condition.
+  {
+    Vector2d ***x_lin = nullptr;
+    ierr = DMDAVecGetArray(m_da, m_x_linearization, &x_lin); PISM_CHK(ierr, "DMDAVecGetArray");
+
+    for (int j = info.gys; j < info.gys + info.gym; j++) {
+      for (int i = info.gxs; i < info.gxs + info.gxm; i++) {
+        for (int k = info.gzs; k < info.gzs + info.gzm; k++) {
+          x_lin[j][i][k] = X[j][i][k]; // STORAGE_ORDER
+        }
+      }
+    }
+
+    ierr = DMDAVecRestoreArray(m_da, m_x_linearization, &x_lin);
+    PISM_CHK(ierr, "DMDAVecRestoreArray");
+  }
+
+  ierr = VecSet(m_J_diagonal, 0.0); PISM_CHK(ierr, "VecSet");
+
+  Vector2d ***D = nullptr;
+  ierr = DMDAVecGetArray(m_da, m_J_diagonal, &D); PISM_CHK(ierr, "DMDAVecGetArray");
+
+  // Note: clear() does not change the capacity, so this does not re-allocate unless the
+  // number of active elements increased.
+  m_qp_data.clear();
+
+  // loop over all the elements that have at least one owned node
+  for (int j = info.gys; j < info.gys + info.gym - 1; j++) {
+    for (int i = info.gxs; i < info.gxs + info.gxm - 1; i++) {
+
+      // Initialize 2D geometric info at element nodes
+      nodal_parameter_values(element, P, i, j,
+                             node_type,
+                             bottom_elevation,
+                             ice_thickness,
+                             NULL,
+                             NULL);
+
+      // skip ice-free (exterior) columns
+      if (exterior_element(node_type)) {
+        continue;
+      }
+
+      for (int k = info.gzs; k < info.gzs + info.gzm - 1; k++) {
+
+        for (int n = 0; n < Nk; ++n) {
+          auto I = element.local_to_global(i, j, k, n);
+
+          z[n] = grid_z(bottom_elevation[n], ice_thickness[n], info.mz, I.k);
+
+          D_nodal[n] = 0.0;
+        }
+
+        element.reset(i, j, k, z);
+
+        element.nodal_values(X, velocity);
+
+        for (int n = 0; n < Nk; ++n) {
+          auto I = element.local_to_global(n);
+          if (dirichlet_node(info, I)) {
+            element.mark_row_invalid(n);
+            velocity[n] = u_bc(element.x(n), element.y(n), element.z(n));
+          }
+        }
+
+        element.nodal_values((double***)hardness, B_nodal);
+
+        element.evaluate(velocity, m_work2[0], u_x, u_y, u_z);
+        element.evaluate(B_nodal, B);
+
+        for (int q = 0; q < element.n_pts(); ++q) {
+          auto W = element.weight(q) / m_scaling;
+
+          double
+            ux = u_x[q].u,
+            uy = u_y[q].u,
+            uz = u_z[q].u,
+            vx = u_x[q].v,
+            vy = u_y[q].v,
+            vz = u_z[q].v;
+
+          double gamma = (ux * ux + vy * vy + ux * vy +
+                          0.25 * ((uy + vx) * (uy + vx) + uz * uz + vz * vz));
+
+          double eta, deta;
+          m_flow_law->effective_viscosity(B[q], gamma, m_viscosity_eps, &eta, &deta);
+
+          // add the enhancement factor
+          eta *= m_E_viscosity;
+          deta *= m_E_viscosity;
+
+          double values[n_qp_values] = {eta, deta, ux, uy, uz, vx, vy, vz};
+          m_qp_data.insert(m_qp_data.end(), values, values + n_qp_values);
+
+          // diagonal entries of the element Jacobian (see jacobian_f())
+          for (int t = 0; t < Nk; ++t) {
+            auto psi = element.chi(q, t);
+
+            double
+              F_u = (psi.dx * (4.0 * ux + 2.0 * vy) + psi.dy * (uy + vx) + psi.dz * uz),
+              F_v = (psi.dx * (uy + vx) + psi.dy * (4.0 * vy + 2.0 * ux) + psi.dz * vz);
+
+            D_nodal[t].u += W * (eta * (4.0 * psi.dx * psi.dx + psi.dy * psi.dy + psi.dz * psi.dz) +
+                                 0.5 * deta * F_u * F_u);
+            D_nodal[t].v += W * (eta * (4.0 * psi.dy * psi.dy + psi.dx * psi.dx + psi.dz * psi.dz) +
+                                 0.5 * deta * F_v * F_v);
+          }
+        }
+
+        // basal boundary
+        if (k == 0) {
+          for (int n = 0; n < Nk; ++n) {
+            auto I = element.local_to_global(n);
+
+            basal_yield_stress[n] = P[I.j][I.i].tauc;
+            floatation[n]         = P[I.j][I.i].floatation;
+          }
+
+          fem::Q1Element3Face *face = grounding_line(floatation) ? &m_face100 : &m_face4;
+
+          face->reset(fem::q13d::FACE_BOTTOM, z);
+
+          double K[2 * Nk][2 * Nk];
+          memset(K, 0, sizeof(K));
+
+          jacobian_basal(*face, basal_yield_stress, floatation, velocity, K);
+
+          for (int t = 0; t < Nk; ++t) {
+            D_nodal[t].u += K[t * 2 + 0][t * 2 + 0];
+            D_nodal[t].v += K[t * 2 + 1][t * 2 + 1];
+          }
+        }
+
+        element.add_contribution(D_nodal, D);
+      } // end of the loop over k
+    } // end of the loop over i
+  } // end of the loop over j
+
+  // identity at Dirichlet nodes (see jacobian_dirichlet())
+  for (int j = info.ys; j < info.ys + info.ym; j++) {
+    for (int i = info.xs; i < info.xs + info.xm; i++) {
+      for (int k = info.zs; k < info.zs + info.zm; k++) {
+        if ((int)P[j][i].node_type == NODE_EXTERIOR or dirichlet_node(info, {i, j, k})) {
+          D[j][i][k] += Vector2d(1.0, 1.0); // STORAGE_ORDER
+        }
+      }
+    }
+  }
+
+  ierr = DMDAVecRestoreArray(m_da, m_J_diagonal, &D); PISM_CHK(ierr, "DMDAVecRestoreArray");
+}
+
+/*!
+ * Compute the action of the Jacobian on `x`, putting the result in `y`.
+ *
+ * Uses quadrature point data stored by store_linearization().
+ */
+void Blatter::jacobian_action(Vec x, Vec y) {
+  PetscErrorCode ierr;
+
+  DMDALocalInfo petsc_info;
+  ierr = DMDAGetLocalInfo(m_da, &petsc_info); PISM_CHK(ierr, "DMDAGetLocalInfo");
+  auto info = grid_transpose(petsc_info);
+
+  double
+    x_min = m_grid->x0() - m_grid->Lx(),
+    y_min = m_grid->y0() - m_grid->Ly(),
+    dx    = m_grid->dx(),
+    dy    = m_grid->dy();
+
+  fem::Q1Element3 element(info,
+                          fem::Q13DQuadrature8(),
+                          dx, dy, x_min, y_min);
+
+  const int Nk = fem::q13d::n_chi;
+
+  double z[Nk];
+  double floatation[Nk], bottom_elevation[Nk], ice_thickness[Nk];
+  double basal_yield_stress[Nk];
+  int node_type[Nk];
+
+  Vector2d du_nodal[Nk], velocity[Nk], y_nodal[Nk];
+
+  Vector2d
+    *du_x = m_work2[1],
+    *du_y = m_work2[2],
+    *du_z = m_work2[3];
+
+  array::AccessScope list(m_parameters);
+  auto *P = m_parameters.array();
+
+  ::Vec x_local;
+  ierr = DMGetLocalVector(m_da, &x_local); PISM_CHK(ierr, "DMGetLocalVector");
+  ierr = DMGlobalToLocalBegin(m_da, x, INSERT_VALUES, x_local); PISM_CHK(ierr, "DMGlobalToLocalBegin");
+  ierr = DMGlobalToLocalEnd(m_da, x, INSERT_VALUES, x_local); PISM_CHK(ierr, "DMGlobalToLocalEnd");
+
+  Vector2d ***X = nullptr, ***X_lin = nullptr, ***Y = nullptr;
+  ierr = DMDAVecGetArrayRead(m_da, x_local, &X); PISM_CHK(ierr, "DMDAVecGetArrayRead");
+  ierr = DMDAVecGetArrayRead(m_da, m_x_linearization, &X_lin);
+  PISM_CHK(ierr, "DMDAVecGetArrayRead");
+
+  ierr = VecSet(y, 0.0); PISM_CHK(ierr, "VecSet");
+  ierr = DMDAVecGetArray(m_da, y, &Y); PISM_CHK(ierr, "DMDAVecGetArray");
+
+  const double *data = m_qp_data.data();
+
+  for (int j = info.gys; j < info.gys + info.gym - 1; j++) {
+    for (int i = info.gxs; i < info.gxs + info.gxm - 1; i++) {
+
+      nodal_parameter_values(element, P, i, j,
+                             node_type,
+                             bottom_elevation,
+                             ice_thickness,
+                             NULL,
+                             NULL);
+
+      if (exterior_element(node_type)) {
+        continue;
+      }
+
+      for (int k = info.gzs; k < info.gzs + info.gzm - 1; k++) {
+
+        for (int n = 0; n < Nk; ++n) {
+          auto I = element.local_to_global(i, j, k, n);
+
+          z[n] = grid_z(bottom_elevation[n], ice_thickness[n], info.mz, I.k);
+
+          y_nodal[n] = 0.0;
+        }
+
+        element.reset(i, j, k, z);
+
+        element.nodal_values((const Vector2d***)X, du_nodal);
+
+        // Dirichlet nodes: the corresponding rows and columns of the Jacobian contain
+        // zeros (except for the diagonal)
+        for (int n = 0; n < Nk; ++n) {
+          auto I = element.local_to_global(n);
+          if (dirichlet_node(info, I)) {
+            element.mark_row_invalid(n);
+            du_nodal[n] = 0.0;
+          }
+        }
+
+        element.evaluate(du_nodal, m_work2[0], du_x, du_y, du_z);
+
+        for (int q = 0; q < element.n_pts(); ++q, data += n_qp_values) {
+          auto W = element.weight(q) / m_scaling;
+
+          double
+            eta  = data[0],
+            deta = data[1],
+            ux   = data[2],
+            uy   = data[3],
+            uz   = data[4],
+            vx   = data[5],
+            vy   = data[6],
+            vz   = data[7];
+
+          double
+            dux = du_x[q].u,
+            duy = du_y[q].u,
+            duz = du_z[q].u,
+            dvx = du_x[q].v,
+            dvy = du_y[q].v,
+            dvz = du_z[q].v;
+
+          // directional derivative of gamma
+          double dgamma = (2.0 * ux * dux + 2.0 * vy * dvy + ux * dvy + vy * dux +
+                           0.5 * ((uy + vx) * (duy + dvx) + uz * duz + vz * dvz));
+
+          double deta_dgamma = deta * dgamma;
+
+          for (int t = 0; t < Nk; ++t) {
+            auto psi = element.chi(q, t);
+
+            double
+              F_u = (psi.dx * (4.0 * ux + 2.0 * vy) + psi.dy * (uy + vx) + psi.dz * uz),
+              F_v = (psi.dx * (uy + vx) + psi.dy * (4.0 * vy + 2.0 * ux) + psi.dz * vz);
+
+            y_nodal[t].u += W * (eta * (psi.dx * (4.0 * dux + 2.0 * dvy) +
+                                        psi.dy * (duy + dvx) +
+                                        psi.dz * duz) +
+                                 deta_dgamma * F_u);
+            y_nodal[t].v += W * (eta * (psi.dx * (duy + dvx) +
+                                        psi.dy * (4.0 * dvy + 2.0 * dux) +
+                                        psi.dz * dvz) +
+                                 deta_dgamma * F_v);
+          }
+        }
+
+        // basal boundary: the number of basal elements is small compared to the total, so
+        // here we compute the element Jacobian and multiply by it
+        if (k == 0) {
+          element.nodal_values((const Vector2d***)X_lin, velocity);
+
+          for (int n = 0; n < Nk; ++n) {
+            auto I = element.local_to_global(n);
+
+            if (dirichlet_node(info, I)) {
+              velocity[n] = u_bc(element.x(n), element.y(n), element.z(n));
+            }
+
+            basal_yield_stress[n] = P[I.j][I.i].tauc;
+            floatation[n]         = P[I.j][I.i].floatation;
+          }
+
+          fem::Q1Element3Face *face = grounding_line(floatation) ? &m_face100 : &m_face4;
+
+          face->reset(fem::q13d::FACE_BOTTOM, z);
+
+          double K[2 * Nk][2 * Nk];
+          memset(K, 0, sizeof(K));
+
+          jacobian_basal(*face, basal_yield_stress, floatation, velocity, K);
+
+          for (int t = 0; t < Nk; ++t) {
+            for (int s = 0; s < Nk; ++s) {
+              y_nodal[t].u += K[t * 2 + 0][s * 2 + 0] * du_nodal[s].u + K[t * 2 + 0][s * 2 + 1] * du_nodal[s].v;
+              y_nodal[t].v += K[t * 2 + 1][s * 2 + 0] * du_nodal[s].u + K[t * 2 + 1][s * 2 + 1] * du_nodal[s].v;
+            }
+          }
+        }
+
+        element.add_contribution(y_nodal, Y);
+      } // end of the loop over k
+    } // end of the loop over i
+  } // end of the loop over j
+
+  assert(data == m_qp_data.data() + m_qp_data.size());
+
+  // identity at Dirichlet nodes
+  for (int j = info.ys; j < info.ys + info.ym; j++) {
+    for (int i = info.xs; i < info.xs + info.xm; i++) {
+      for (int k = info.zs; k < info.zs + info.zm; k++) {
+        if ((int)P[j][i].node_type == NODE_EXTERIOR or dirichlet_node(info, {i, j, k})) {
+          Y[j][i][k] += X[j][i][k]; // STORAGE_ORDER
+        }
+      }
+    }
+  }
+
+  ierr = DMDAVecRestoreArray(m_da, y, &Y); PISM_CHK(ierr, "DMDAVecRestoreArray");
+  ierr = DMDAVecRestoreArrayRead(m_da, m_x_linearization, &X_lin);
+  PISM_CHK(ierr, "DMDAVecRestoreArrayRead");
+  ierr = DMDAVecRestoreArrayRead(m_da, x_local, &X); PISM_CHK(ierr, "DMDAVecRestoreArrayRead");
+  ierr = DMRestoreLocalVector(m_da, &x_local); PISM_CHK(ierr, "DMRestoreLocalVector");
+}
+
+/*!
+ * Return the amount of memory (in bytes, summed over all ranks) used to store the
+ * Jacobian on the finest multigrid level.
+ */
+double Blatter::jacobian_memory() const {
+  double result = 0.0;
+
+  if (m_matrix_free) {
+    PetscInt n_local = 0;
+    PetscErrorCode ierr = VecGetLocalSize(m_x, &n_local); PISM_CHK(ierr, "VecGetLocalSize");
+
+    // quadrature point data, the local copy of the linearization point and the diagonal
+    result = (m_qp_data.capacity() * sizeof(double) +
+              2.0 * n_local * sizeof(PetscScalar));
+  } else {
+    Mat J = NULL;
+    PetscErrorCode ierr = SNESGetJacobian(m_snes, NULL, &J, NULL, NULL);
+    PISM_CHK(ierr, "SNESGetJacobian");
+
+    if (J != NULL) {
+      MatInfo info;
+      ierr = MatGetInfo(J, MAT_LOCAL, &info); PISM_CHK(ierr, "MatGetInfo");
+      // values and column indices
+      result = info.nz_allocated * (sizeof(PetscScalar) + sizeof(PetscInt));
+    }
+  }
+
+  return GlobalSum(m_grid->com, result);
+}
+
+PetscErrorCode Blatter::jacobian_action_callback(Mat A, Vec x, Vec y) {
+  Blatter *solver = nullptr;
+  PetscErrorCode ierr = MatShellGetContext(A, &solver); CHKERRQ(ierr);
+
+  try {
+    solver->jacobian_action(x, y);
+  } catch (...) {
+    MPI_Comm com = solver->grid()->com;
+    handle_fatal_errors(com);
+    SETERRQ(com, 1, "A PISM callback failed");
+  }
+  return 0;
+}
+
+PetscErrorCode Blatter::jacobian_diagonal_callback(Mat A, Vec d) {
+  Blatter *solver = nullptr;
+  PetscErrorCode ierr = MatShellGetContext(A, &solver); CHKERRQ(ierr);
+
+  ierr = VecCopy(solver->m_J_diagonal, d); CHKERRQ(ierr);
+
+  return 0;
+}
+
+} // end of namespace stressbalance
+} // end of namespace pism
@@ -17,6 +17,9 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <cassert>
+#include <algorithm>            // std::max, std::min
+#include <limits>
+#include <vector>
 
 #include "pism/stressbalance/sia/BedSmoother.hh"
 #include "pism/util/Context.hh"
@@ -137,6 +140,22 @@ void BedSmoother::preprocess_bed(const array::Scalar &topg,
   m_Nx = Nx;
   m_Ny = Ny;
 
+  if (m_config->get_string("stress_balance.sia.bed_smoother.method") == "parallel") {
+    // The parallel method needs ghosts as wide as the half-width of the smoothing window.
+    // PETSc does not support stencils wider than sub-domains, so we have to use the
+    // serial method if sub-domains are too small.
+    double min_width = GlobalMin(m_grid->com, (double)std::min(m_grid->xm(), m_grid->ym()));
+
+    if (std::max(Nx, Ny) <= min_width) {
+      preprocess_bed_parallel(topg);
+      return;
+    }
+
+    m_grid->ctx()->log()->message(3,
+                                  "  BedSmoother: sub-domains are too small for the parallel "
+                                  "method; using the serial one\n");
+  }
+
   topg.put_on_proc0(*m_topgp0);
   smooth_the_bed_on_proc0();
   // next call *does indeed* fill ghosts in topgsmooth
@@ -151,6 +170,229 @@ void BedSmoother::preprocess_bed(const array::Scalar &topg,
 }
 
 
+//! Integer division rounding towards negative infinity.
+static int floor_div(int a, int b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/*!
+ * Number of points, the mean, and sums of powers 2, 3 and 4 of deviations from the mean
+ * of a set of values.
+ */
+struct Moments {
+  double n, mean, M2, M3, M4;
+};
+
+/*!
+ * Moments of the union of two sets, computed using moments of these sets.
+ *
+ * Uses formulas from P. Pebay, "Formulas for robust, one-pass parallel computation of
+ * covariances and arbitrary-order statistical moments", Sandia report SAND2008-6212, 2008.
+ * Unlike sums of powers of values these do not suffer from cancellation.
+ */
+static Moments merge(const Moments &A, const Moments &B) {
+  if (A.n == 0.0) {
+    return B;
+  }
+  if (B.n == 0.0) {
+    return A;
+  }
+
+  const double
+    nA = A.n,
+    nB = B.n,
+    n  = nA + nB,
+    d  = B.mean - A.mean,
+    d2 = d * d;
+
+  Moments result;
+  result.n    = n;
+  result.mean = A.mean + d * nB / n;
+  result.M2   = A.M2 + B.M2 + d2 * nA * nB / n;
+  result.M3   = (A.M3 + B.M3 + d2 * d * nA * nB * (nA - nB) / (n * n) +
+                 3.0 * d * (nA * B.M2 - nB * A.M2) / n);
+  result.M4   = (A.M4 + B.M4 + d2 * d2 * nA * nB * (nA * nA - nA * nB + nB * nB) / (n * n * n) +
+                 6.0 * d2 * (nA * nA * B.M2 + nB * nB * A.M2) / (n * n) +
+                 4.0 * d * (nA * B.M3 - nB * A.M3) / n);
+  return result;
+}
+
+/*!
+ * Reduce (using the associative operation `op`) `values` over windows of width `2 N + 1`.
+ *
+ * Here `values[k]` corresponds to the global index `first + k` and on return `result[k]`
+ * contains the reduction over global indexes `[first + k - N, first + k + N]` for `k` in
+ * `[N, size - N)`.
+ *
+ * Uses the van Herk/Gil-Werman algorithm: the index space is split into blocks of width
+ * `W = 2 N + 1`. A window either coincides with a block or covers the end of one block and
+ * the beginning of the next one, so it is a combination of at most one suffix and one prefix
+ * reduction within blocks. The cost per point does not depend on `N`.
+ *
+ * Blocks are aligned with the global index `-N`, so results do not depend on `first`, i.e.
+ * on the domain decomposition.
+ */
+template <typename T, class Op>
+static void window_reduce(const T *values, int size, int first, int N, Op op,
+                          std::vector<T> &prefix, std::vector<T> &suffix, T *result) {
+  const int W = 2 * N + 1;
+
+  auto block_start = [W, N](int x) { return floor_div(x + N, W) * W - N; };
+
+  prefix.resize(size);
+  suffix.resize(size);
+
+  for (int k = 0; k < size; ++k) {
+    int x = first + k;
+    prefix[k] = (k == 0 or x == block_start(x)) ? values[k] : op(prefix[k - 1], values[k]);
+  }
+
+  for (int k = size - 1; k >= 0; --k) {
+    int x = first + k;
+    bool block_end = (x + 1 == block_start(x + 1));
+    suffix[k] = (k == size - 1 or block_end) ? values[k] : op(values[k], suffix[k + 1]);
+  }
+
+  for (int k = N; k < size - N; ++k) {
+    int a = k - N, b = k + N;
+
+    if (first + a == block_start(first + a)) {
+      result[k] = prefix[b];
+    } else {
+      result[k] = op(suffix[a], prefix[b]);
+    }
+  }
+}
+
+/*!
+ * Reduce values in the rectangle `[X0, X0 + xw) x [Y0, Y0 + yw)` (stored row by row in
+ * `values`) over windows of size `(2 Nx + 1) x (2 Ny + 1)` centered at points of the
+ * rectangle `[X0 + Nx, X0 + xw - Nx) x [Y0 + Ny, Y0 + yw - Ny)`, storing results row by row
+ * in `result`.
+ */
+template <typename T, class Op>
+static void window_reduce_2d(const std::vector<T> &values, int X0, int Y0, int xw, int yw,
+                             int Nx, int Ny, Op op, std::vector<T> &result) {
+  const int
+    xm = xw - 2 * Nx,
+    ym = yw - 2 * Ny;
+
+  std::vector<T> prefix, suffix, column(yw), output(std::max(xw, yw));
+
+  // reduce along rows...
+  std::vector<T> rows(xm * yw);
+  for (int r = 0; r < yw; ++r) {
+    window_reduce(&values[r * xw], xw, X0, Nx, op, prefix, suffix, output.data());
+
+    std::copy(output.begin() + Nx, output.begin() + Nx + xm, rows.begin() + r * xm);
+  }
+
+  // ... then along columns
+  result.resize(xm * ym);
+  for (int q = 0; q < xm; ++q) {
+    for (int r = 0; r < yw; ++r) {
+      column[r] = rows[r * xm + q];
+    }
+
+    window_reduce(column.data(), yw, Y0, Ny, op, prefix, suffix, output.data());
+
+    for (int r = 0; r < ym; ++r) {
+      result[r * xm + q] = output[r + Ny];
+    }
+  }
+}
+
+/*!
+ * Compute the smoothed bed and coefficients of the bed roughness parameterization using
+ * windowed reductions computed on all processes.
+ *
+ * The mean and central moments of the bed elevation over a window are computed by merging
+ * moments of parts of the window (see window_reduce()), so the cost per grid point does not
+ * depend on the size of the smoothing window. Results match the ones computed by the serial
+ * code up to rounding errors and do not depend on the domain decomposition.
+ */
+void BedSmoother::preprocess_bed_parallel(const array::Scalar &topg) {
+  const int
+    Mx = (int)m_grid->Mx(),
+    My = (int)m_grid->My(),
+    Nx = m_Nx,
+    Ny = m_Ny,
+    xs = m_grid->xs(),
+    ys = m_grid->ys(),
+    xm = m_grid->xm(),
+    X0 = xs - Nx,
+    Y0 = ys - Ny,
+    xw = xm + 2 * Nx,
+    yw = m_grid->ym() + 2 * Ny,
+    width = std::max(Nx, Ny);
+
+  if (m_topg_wide == nullptr or (int)m_topg_wide->stencil_width() != width) {
+    m_topg_wide = std::make_shared<array::Array2D<double> >(m_grid, "topg_wide",
+                                                            array::WITH_GHOSTS, width);
+  }
+  auto &b = *m_topg_wide;
+  b.copy_from(topg);
+
+  // Bed elevation in the window around the current sub-domain. Points outside of the domain
+  // are represented by empty sets (moments) and -infinity (maximum): smoothing does not wrap
+  // around periodically.
+  std::vector<Moments> moments(xw * yw);
+  std::vector<double> elevation(xw * yw);
+  {
+    array::AccessScope list{ &b };
+
+    for (int r = 0; r < yw; ++r) {
+      for (int q = 0; q < xw; ++q) {
+        int i = X0 + q, j = Y0 + r, k = r * xw + q;
+
+        if (i >= 0 and i < Mx and j >= 0 and j < My) {
+          moments[k]   = { 1.0, b(i, j), 0.0, 0.0, 0.0 };
+          elevation[k] = b(i, j);
+        } else {
+          moments[k]   = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+          elevation[k] = -std::numeric_limits<double>::infinity();
+        }
+      }
+    }
+  }
+
+  std::vector<Moments> window_moments;
+  window_reduce_2d(moments, X0, Y0, xw, yw, Nx, Ny, merge, window_moments);
+
+  std::vector<double> window_max;
+  window_reduce_2d(elevation, X0, Y0, xw, yw, Nx, Ny,
+                   [](double x, double y) { return std::max(x, y); }, window_max);
+
+  // scale the coeffs in Taylor series
+  const double
+    n  = m_Glen_exponent,
+    k  = (n + 2) / n,
+    s2 = k * (2 * n + 2) / (2 * n),
+    s3 = s2 * (3 * n + 2) / (3 * n),
+    s4 = s3 * (4 * n + 2) / (4 * n);
+
+  array::AccessScope list{ &m_topgsmooth, &m_maxtl, &m_C2, &m_C3, &m_C4 };
+
+  for (auto p = m_grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    const auto &M = window_moments[(j - ys) * xm + (i - xs)];
+
+    m_topgsmooth(i, j) = M.mean;
+    m_maxtl(i, j)      = std::max(window_max[(j - ys) * xm + (i - xs)] - M.mean, 0.0);
+
+    m_C2(i, j) = M.M2 / M.n * s2;
+    m_C3(i, j) = M.M3 / M.n * s3;
+    m_C4(i, j) = M.M4 / M.n * s4;
+  }
+
+  m_topgsmooth.update_ghosts();
+  m_maxtl.update_ghosts();
+  m_C2.update_ghosts();
+  m_C3.update_ghosts();
+  m_C4.update_ghosts();
+}
+
 //! Computes the smoothed bed by a simple average over a rectangle of grid points.
 void BedSmoother::smooth_the_bed_on_proc0() {
 
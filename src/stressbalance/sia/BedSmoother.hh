@@ -125,6 +125,11 @@ protected:
 
   void smooth_the_bed_on_proc0();
   void compute_coefficients_on_proc0();
+
+  void preprocess_bed_parallel(const array::Scalar &topg);
+
+  //! copy of the bed elevation with ghosts wide enough to compute windowed sums
+  std::shared_ptr<array::Array2D<double> > m_topg_wide;
 };
 
 } // end of namespace stressbalance
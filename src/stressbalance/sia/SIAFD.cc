@@ -50,6 +50,10 @@ SIAFD::SIAFD(std::shared_ptr<const Grid> g)
       m_delta_1(m_grid, "delta_1", array::WITH_GHOSTS, m_grid->z()),
       m_work_3d_0(m_grid, "work_3d_0", array::WITH_GHOSTS, m_grid->z()),
       m_work_3d_1(m_grid, "work_3d_1", array::WITH_GHOSTS, m_grid->z()) {
+  for (auto *v : { &m_delta_0, &m_delta_1, &m_work_3d_0, &m_work_3d_1 }) {
+    v->enable_compression();
+  }
+
   // bed smoother
   m_bed_smoother = new BedSmoother(m_grid);
 
@@ -16,15 +16,21 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "pism/stressbalance/ssa/SSA.hh"
 #include "pism/util/EnthalpyConverter.hh"
 #include "pism/rheology/FlowLawFactory.hh"
+#include "pism/rheology/FlowLaw.hh"
 #include "pism/util/Mask.hh"
 #include "pism/util/error_handling.hh"
 #include "pism/util/io/File.hh"
 #include "pism/util/array/CellType.hh"
 #include "pism/stressbalance/StressBalance.hh"
 #include "pism/geometry/Geometry.hh"
+#include "pism/util/pism_utilities.hh"
 
 #include "pism/stressbalance/ssa/SSA_diagnostics.hh"
 
@@ -79,6 +85,41 @@ SSA::SSA(std::shared_ptr<const Grid> g)
 
   strength_extension = new SSAStrengthExtension(*m_config);
 
+  {
+    m_adaptive.enabled              = m_config->get_flag("stress_balance.ssa.adaptive.enabled");
+    m_adaptive.error_budget         = m_config->get_number("stress_balance.ssa.adaptive.error_budget");
+    m_adaptive.max_tolerance_factor =
+        std::max(m_config->get_number("stress_balance.ssa.adaptive.max_tolerance_factor"), 1.0);
+    m_adaptive.min_tolerance_factor =
+        std::min(m_config->get_number("stress_balance.ssa.adaptive.min_tolerance_factor"), 1.0);
+    m_adaptive.max_skipped_steps =
+        static_cast<unsigned int>(m_config->get_number("stress_balance.ssa.adaptive.max_skipped_steps"));
+    m_adaptive.tolerance_factor      = 1.0;
+
+    if (not(m_adaptive.min_tolerance_factor > 0.0)) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "stress_balance.ssa.adaptive.min_tolerance_factor"
+                                    " has to be positive (got %f)",
+                                    m_adaptive.min_tolerance_factor);
+    }
+
+    m_adaptive.valid                 = false;
+    m_adaptive.last_iterations       = 0;
+    m_adaptive.n_solves              = 0;
+    m_adaptive.n_skipped             = 0;
+    m_adaptive.n_skipped_since_solve = 0;
+    m_adaptive.total_iterations      = 0;
+
+    if (m_adaptive.enabled) {
+      m_adaptive.taud      = std::make_shared<array::Vector>(m_grid, "taud_last_solve");
+      m_adaptive.tauc      = std::make_shared<array::Scalar>(m_grid, "tauc_last_solve");
+      m_adaptive.cell_type = std::make_shared<array::Scalar>(m_grid, "cell_type_last_solve");
+      m_adaptive.velocity  = std::make_shared<array::Vector>(m_grid, "velocity_last_solve");
+
+      m_adaptive.current_hardness = std::make_shared<array::Scalar>(m_grid, "hardness");
+    }
+  }
+
   // grounded_dragging_floating integer mask
   m_mask.metadata(0)
       .long_name("ice-type (ice-free/grounded/floating/ocean) integer mask");
@@ -165,7 +206,17 @@ void SSA::update(const Inputs &inputs, bool full_update) {
   }
 
   if (full_update) {
-    solve(inputs);
+    if (m_adaptive.enabled) {
+      // solve_is_needed() compares the driving stress to the one used by the last solve
+      // (SSAFD uses it in solve() as well; otherwise SSAFD computes it in assemble_rhs())
+      compute_driving_stress(inputs.geometry->ice_thickness, inputs.geometry->ice_surface_elevation,
+                             m_mask, inputs.no_model_mask, m_taud);
+    }
+
+    if (solve_is_needed(inputs)) {
+      solve(inputs);
+      record_solve(inputs);
+    }
     compute_basal_frictional_heating(m_velocity,
                                      *inputs.basal_yield_stress,
                                      m_mask,
@@ -173,6 +224,223 @@ void SSA::update(const Inputs &inputs, bool full_update) {
   }
 }
 
+/*!
+ * Relative change of `current` compared to `reference`, measured in the L1 norm of the
+ * magnitude of the difference.
+ */
+static double relative_change(const array::Vector &current, const array::Vector &reference) {
+  auto grid = current.grid();
+
+  array::AccessScope list{ &current, &reference };
+
+  double change = 0.0, norm = 0.0;
+  for (auto p = grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    change += (current(i, j) - reference(i, j)).magnitude();
+    norm += reference(i, j).magnitude();
+  }
+  change = GlobalSum(grid->com, change);
+  norm   = GlobalSum(grid->com, norm);
+
+  if (norm > 0.0) {
+    return change / norm;
+  }
+  return change > 0.0 ? 1.0 : 0.0;
+}
+
+static double relative_change(const array::Scalar &current, const array::Scalar &reference) {
+  auto grid = current.grid();
+
+  array::AccessScope list{ &current, &reference };
+
+  double change = 0.0, norm = 0.0;
+  for (auto p = grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    change += std::abs(current(i, j) - reference(i, j));
+    norm += std::abs(reference(i, j));
+  }
+  change = GlobalSum(grid->com, change);
+  norm   = GlobalSum(grid->com, norm);
+
+  if (norm > 0.0) {
+    return change / norm;
+  }
+  return change > 0.0 ? 1.0 : 0.0;
+}
+
+/*!
+ * Relative change of an optional input. Returns infinity if the input was added or
+ * removed since the last solve.
+ */
+template <class T>
+static double relative_change(const T *current, const std::shared_ptr<T> &reference) {
+  if ((current == nullptr) != (reference == nullptr)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  if (current == nullptr) {
+    return 0.0;
+  }
+  return relative_change(*current, *reference);
+}
+
+/*!
+ * Store a copy of an optional input in `copy`, allocating it if necessary. Resets `copy`
+ * if the input is not provided.
+ */
+template <class T>
+static void store(const T *input, std::shared_ptr<T> &copy, std::shared_ptr<const Grid> grid,
+                  const std::string &name) {
+  if (input == nullptr) {
+    copy.reset();
+    return;
+  }
+  if (not copy) {
+    copy = std::make_shared<T>(grid, name);
+  }
+  copy->copy_from(*input);
+}
+
+//! Number of grid points where integer masks `a` and `b` differ.
+static int count_differences(const array::Scalar &a, const array::Scalar &b) {
+  auto grid = a.grid();
+
+  array::AccessScope list{ &a, &b };
+
+  int result = 0;
+  for (auto p = grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    if (a.as_int(i, j) != b.as_int(i, j)) {
+      result += 1;
+    }
+  }
+  return GlobalSum(grid->com, result);
+}
+
+/*!
+ * Returns `true` if the SSA has to be solved during the current update.
+ *
+ * In the adaptive mode the velocity computed during the last solve is re-used as long as
+ * the cell type mask and the Dirichlet B.C. mask do not change and the relative change in
+ * the driving stress, the basal yield stress, the vertically-averaged ice hardness, the
+ * Dirichlet B.C. values, the water column pressure and the fracture density since that
+ * solve stays below `stress_balance.ssa.adaptive.error_budget`.
+ *
+ * Expects the driving stress in `m_taud` to be up to date.
+ */
+bool SSA::solve_is_needed(const Inputs &inputs) {
+  if (not m_adaptive.enabled) {
+    return true;
+  }
+
+  if (inputs.enthalpy != nullptr) {
+    rheology::averaged_hardness_vec(*m_flow_law, inputs.geometry->ice_thickness,
+                                    *inputs.enthalpy, *m_adaptive.current_hardness);
+  }
+
+  if (not m_adaptive.valid or m_adaptive.n_skipped_since_solve >= m_adaptive.max_skipped_steps) {
+    return true;
+  }
+
+  if (count_differences(m_mask, *m_adaptive.cell_type) > 0) {
+    return true;
+  }
+
+  if ((inputs.bc_mask == nullptr) != (m_adaptive.bc_mask == nullptr) or
+      (inputs.bc_mask != nullptr and count_differences(*inputs.bc_mask, *m_adaptive.bc_mask) > 0)) {
+    return true;
+  }
+
+  const array::Scalar *hardness =
+      inputs.enthalpy != nullptr ? m_adaptive.current_hardness.get() : nullptr;
+
+  double change = std::max({ relative_change(m_taud, *m_adaptive.taud),
+                             relative_change(*inputs.basal_yield_stress, *m_adaptive.tauc),
+                             relative_change(hardness, m_adaptive.hardness),
+                             relative_change(inputs.bc_values, m_adaptive.bc_values),
+                             relative_change(inputs.water_column_pressure,
+                                             m_adaptive.water_column_pressure),
+                             relative_change(inputs.fracture_density,
+                                             m_adaptive.fracture_density) });
+
+  if (change >= m_adaptive.error_budget) {
+    return true;
+  }
+
+  m_adaptive.n_skipped += 1;
+  m_adaptive.n_skipped_since_solve += 1;
+
+  m_stdout_ssa.clear();
+  if (m_log->get_threshold() >= 2) {
+    double iterations_per_solve =
+        m_adaptive.n_solves > 0 ? (double)m_adaptive.total_iterations / m_adaptive.n_solves : 0.0;
+
+    m_stdout_ssa = pism::printf("  SSA: re-used velocity (input change %.1e < %.1e); "
+                                "%d of %d updates skipped, ~%.0f nonlinear iterations saved\n",
+                                change, m_adaptive.error_budget, (int)m_adaptive.n_skipped,
+                                (int)(m_adaptive.n_skipped + m_adaptive.n_solves),
+                                m_adaptive.n_skipped * iterations_per_solve);
+  }
+
+  return false;
+}
+
+/*!
+ * Store inputs and the velocity after a successful solve and update the factor used to
+ * scale solver tolerances.
+ *
+ * The factor is the ratio of the relative velocity change since the last solve to the
+ * error budget, limited to `[min_tolerance_factor, max_tolerance_factor]`. Tolerances are
+ * loosened if the velocity changed a lot (the solver error is small compared to the
+ * change) and tightened if it barely changed, so that the solver error stays small
+ * compared to the change in the solution and does not accumulate over skipped steps.
+ */
+void SSA::record_solve(const Inputs &inputs) {
+  if (not m_adaptive.enabled) {
+    return;
+  }
+
+  if (m_adaptive.valid) {
+    double velocity_change = relative_change(m_velocity, *m_adaptive.velocity);
+    double f_min           = m_adaptive.min_tolerance_factor;
+    double f_max           = m_adaptive.max_tolerance_factor;
+
+    m_adaptive.tolerance_factor =
+        std::min(std::max(velocity_change / m_adaptive.error_budget, f_min), f_max);
+
+    if (m_log->get_threshold() >= 2) {
+      if (not m_stdout_ssa.empty() and m_stdout_ssa.back() != '\n') {
+        m_stdout_ssa += "\n";
+      }
+      m_stdout_ssa += pism::printf("  SSA: tolerance factor %.2f (velocity change %.1e)\n",
+                                   m_adaptive.tolerance_factor, velocity_change);
+    }
+  }
+
+  m_adaptive.velocity->copy_from(m_velocity);
+  m_adaptive.taud->copy_from(m_taud);
+  m_adaptive.tauc->copy_from(*inputs.basal_yield_stress);
+  m_adaptive.cell_type->copy_from(m_mask);
+
+  const array::Scalar *hardness =
+      inputs.enthalpy != nullptr ? m_adaptive.current_hardness.get() : nullptr;
+
+  store(hardness, m_adaptive.hardness, m_grid, "hardness_last_solve");
+  store(inputs.water_column_pressure, m_adaptive.water_column_pressure, m_grid,
+        "water_column_pressure_last_solve");
+  store(inputs.fracture_density, m_adaptive.fracture_density, m_grid,
+        "fracture_density_last_solve");
+  store(inputs.bc_mask, m_adaptive.bc_mask, m_grid, "bc_mask_last_solve");
+  store(inputs.bc_values, m_adaptive.bc_values, m_grid, "bc_values_last_solve");
+
+  m_adaptive.n_solves += 1;
+  m_adaptive.total_iterations += m_adaptive.last_iterations;
+  m_adaptive.n_skipped_since_solve = 0;
+  m_adaptive.valid                 = true;
+}
+
 /*!
  * Compute the weight used to determine if the difference between locations `i,j` and `n`
  * (neighbor) should be used in the computation of the surface gradient in
@@ -384,6 +652,7 @@ std::string SSA::stdout_report() const {
 //! \brief Set the initial guess of the SSA velocity.
 void SSA::set_initial_guess(const array::Vector &guess) {
   m_velocity.copy_from(guess);
+  m_adaptive.valid = false;
 }
 
 const array::Vector& SSA::driving_stress() const {
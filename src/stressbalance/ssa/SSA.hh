@@ -22,6 +22,8 @@
 #include "pism/stressbalance/ShallowStressBalance.hh"
 #include "pism/util/array/CellType.hh"
 
+#include <memory>
+
 namespace pism {
 
 class Geometry;
@@ -143,6 +145,39 @@ protected:
   array::CellType2 m_mask;
   array::Vector m_taud;
 
+  //! Book-keeping for the adaptive mode (stress_balance.ssa.adaptive.*).
+  struct AdaptiveSolve {
+    bool enabled;
+    //! maximum relative change in SSA inputs allowed before a re-solve
+    double error_budget;
+    //! bounds on the factor used to scale solver tolerances
+    double min_tolerance_factor, max_tolerance_factor;
+    unsigned int max_skipped_steps;
+    //! factor applied to solver tolerances by derived classes
+    double tolerance_factor;
+    //! true if inputs at the last solve are stored below
+    bool valid;
+    //! number of nonlinear iterations reported by the last solve
+    unsigned int last_iterations;
+    unsigned int n_solves, n_skipped, n_skipped_since_solve, total_iterations;
+    //! inputs and the velocity at the time of the last solve
+    std::shared_ptr<array::Vector> taud;
+    std::shared_ptr<array::Scalar> tauc;
+    std::shared_ptr<array::Scalar> cell_type;
+    std::shared_ptr<array::Vector> velocity;
+    //! optional inputs at the time of the last solve (empty if not provided)
+    std::shared_ptr<array::Scalar> hardness;
+    std::shared_ptr<array::Scalar> water_column_pressure;
+    std::shared_ptr<array::Scalar> fracture_density;
+    std::shared_ptr<array::Scalar> bc_mask;
+    std::shared_ptr<array::Vector> bc_values;
+    //! vertically-averaged ice hardness computed using current inputs
+    std::shared_ptr<array::Scalar> current_hardness;
+  } m_adaptive;
+
+  bool solve_is_needed(const Inputs &inputs);
+  void record_solve(const Inputs &inputs);
+
   std::string m_stdout_ssa;
 
   // objects used by the SSA solver (internally)
@@ -224,7 +224,7 @@ discrete approximation of the right side.  For more about the discretization
 of the SSA equations, see comments for assemble_matrix().
 
 The values of the driving stress on the i,j grid come from a call to
-compute_driving_stress().
+compute_driving_stress() (in SSA::update() if the adaptive mode is enabled).
 
 In the case of Dirichlet boundary conditions, the entries on the right-hand side
 come from known velocity values.  The fields m_bc_values and m_bc_mask are used for
@@ -256,8 +256,11 @@ void SSAFD::assemble_rhs(const Inputs &inputs) {
   // FIXME: bedrock_boundary is a misleading name
   bool bedrock_boundary = m_config->get_flag("stress_balance.ssa.dirichlet_bc");
 
-  compute_driving_stress(inputs.geometry->ice_thickness, inputs.geometry->ice_surface_elevation,
-                         m_mask, inputs.no_model_mask, m_taud);
+  if (not m_adaptive.enabled) {
+    // in the adaptive mode the driving stress is computed in SSA::update()
+    compute_driving_stress(inputs.geometry->ice_thickness, inputs.geometry->ice_surface_elevation,
+                           m_mask, inputs.no_model_mask, m_taud);
+  }
 
   array::AccessScope list{ &m_taud, &m_b };
 
@@ -1041,8 +1044,10 @@ void SSAFD::picard_manager(const Inputs &inputs, double nuH_regularization,
 
   int max_iterations =
       static_cast<int>(m_config->get_number("stress_balance.ssa.fd.max_iterations"));
+  // m_adaptive.tolerance_factor is 1 unless stress_balance.ssa.adaptive.enabled is set
   double ssa_relative_tolerance =
-      m_config->get_number("stress_balance.ssa.fd.relative_convergence");
+      m_config->get_number("stress_balance.ssa.fd.relative_convergence") *
+      m_adaptive.tolerance_factor;
   bool verbose = m_log->get_threshold() >= 2, very_verbose = m_log->get_threshold() > 2;
 
   // set the initial guess:
@@ -1187,6 +1192,8 @@ void SSAFD::picard_manager(const Inputs &inputs, double nuH_regularization,
 
 done:
 
+  m_adaptive.last_iterations = outer_iterations;
+
   if (very_verbose) {
     auto tempstr =
         pism::printf("... =%5d outer iterations, ~%3.1f KSP iterations each\n",
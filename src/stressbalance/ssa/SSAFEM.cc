@@ -100,6 +100,9 @@ SSAFEM::SSAFEM(std::shared_ptr<const Grid> grid)
   ierr = SNESSetFromOptions(m_snes);
   PISM_CHK(ierr, "SNESSetFromOptions");
 
+  ierr = SNESGetTolerances(m_snes, NULL, &m_snes_rtol, NULL, NULL, NULL);
+  PISM_CHK(ierr, "SNESGetTolerances");
+
   m_node_type.metadata(0).long_name(
       "node types: interior, boundary, exterior"); // no units or standard name
 
@@ -159,6 +162,17 @@ void SSAFEM::init_impl() {
  */
 void SSAFEM::solve(const Inputs &inputs) {
 
+  if (m_adaptive.enabled) {
+    PetscReal atol, rtol, stol;
+    PetscInt max_it, max_f;
+    PetscErrorCode ierr = SNESGetTolerances(m_snes, &atol, &rtol, &stol, &max_it, &max_f);
+    PISM_CHK(ierr, "SNESGetTolerances");
+
+    ierr = SNESSetTolerances(m_snes, atol, m_snes_rtol * m_adaptive.tolerance_factor, stol,
+                             max_it, max_f);
+    PISM_CHK(ierr, "SNESSetTolerances");
+  }
+
   auto reason = solve_with_reason(inputs);
   if (reason->failed()) {
     throw RuntimeError::formatted(PISM_ERROR_LOCATION,
@@ -169,6 +183,11 @@ void SSAFEM::solve(const Inputs &inputs) {
   if (m_log->get_threshold() > 2) {
     m_stdout_ssa += "SSAFEM converged (SNES reason " + reason->description() + ")";
   }
+
+  PetscInt snes_iterations = 0;
+  PetscErrorCode ierr = SNESGetIterationNumber(m_snes, &snes_iterations);
+  PISM_CHK(ierr, "SNESGetIterationNumber");
+  m_adaptive.last_iterations = snes_iterations;
 }
 
 std::shared_ptr<TerminationReason> SSAFEM::solve_with_reason(const Inputs &inputs) {
@@ -330,6 +349,7 @@ void SSAFEM::cache_inputs(const Inputs &inputs) {
 
   cache_residual_cfbc(inputs);
 
+  cache_quad_point_values();
 }
 
 //! Compute quadrature point values of various coefficients given a quadrature `Q` and nodal values.
@@ -365,6 +385,104 @@ void SSAFEM::quad_point_values(const fem::Element &E,
   }
 }
 
+//! Compute and store coefficients at quadrature points of all elements in this sub-domain.
+/**
+   Coefficients do not change during a solve, so this avoids re-computing them during
+   every residual and Jacobian evaluation.
+
+   Uses m_coefficients and m_node_type. Has to be called every time m_coefficients are
+   modified.
+*/
+void SSAFEM::cache_quad_point_values() {
+
+  const bool use_explicit_driving_stress = (m_driving_stress_x != NULL) && (m_driving_stress_y != NULL);
+
+  const bool use_cfbc = m_config->get_flag("stress_balance.calving_front_stress_bc");
+
+  const unsigned int Nk = fem::q1::n_chi;
+  const unsigned int Nq_max = fem::MAX_QUADRATURE_SIZE;
+
+  using fem::P1Element2;
+  fem::P1Quadrature3 Q_p1;
+  P1Element2 p1_element[Nk] = {P1Element2(*m_grid, Q_p1, 0),
+                               P1Element2(*m_grid, Q_p1, 1),
+                               P1Element2(*m_grid, Q_p1, 2),
+                               P1Element2(*m_grid, Q_p1, 3)};
+
+  auto &C = m_qp_cache;
+
+  // Note: clear() does not change the capacity, so this does not re-allocate unless the
+  // number of elements increased.
+  C.element_type.clear();
+  C.offset.clear();
+  C.mask.clear();
+  C.thickness.clear();
+  C.tauc.clear();
+  C.hardness.clear();
+  C.driving_stress.clear();
+
+  array::AccessScope list{&m_node_type, &m_coefficients};
+
+  const int
+    xs = m_element_index.xs,
+    xm = m_element_index.xm,
+    ys = m_element_index.ys,
+    ym = m_element_index.ym;
+
+  for (int j = ys; j < ys + ym; j++) {
+    for (int i = xs; i < xs + xm; i++) {
+      m_q1_element.reset(i, j);
+
+      // if use_cfbc == false all elements are interior and Q1
+      int type = fem::ELEMENT_Q;
+      if (use_cfbc) {
+        int node_type[Nk];
+        m_q1_element.nodal_values(m_node_type, node_type);
+
+        type = fem::element_type(node_type);
+      }
+
+      C.element_type.push_back(type);
+      C.offset.push_back(static_cast<int>(C.thickness.size()));
+
+      if (type == fem::ELEMENT_EXTERIOR) {
+        continue;
+      }
+
+      fem::Element2 *E = &m_q1_element;
+      if (type != fem::ELEMENT_Q) {
+        E = &p1_element[type];
+        E->reset(i, j);
+      }
+
+      int      mask[Nq_max];
+      double   thickness[Nq_max];
+      double   tauc[Nq_max];
+      double   hardness[Nq_max];
+      Vector2d tau_d[Nq_max];
+
+      Coefficients coeffs[Nk];
+      E->nodal_values(m_coefficients.array(), coeffs);
+
+      quad_point_values(*E, coeffs, mask, thickness, tauc, hardness);
+
+      if (use_explicit_driving_stress) {
+        explicit_driving_stress(*E, coeffs, tau_d);
+      } else {
+        driving_stress(*E, coeffs, tau_d);
+      }
+
+      const unsigned int Nq = E->n_pts();
+
+      C.mask.insert(C.mask.end(), mask, mask + Nq);
+      C.thickness.insert(C.thickness.end(), thickness, thickness + Nq);
+      C.tauc.insert(C.tauc.end(), tauc, tauc + Nq);
+      C.hardness.insert(C.hardness.end(), hardness, hardness + Nq);
+      C.driving_stress.insert(C.driving_stress.end(), tau_d, tau_d + Nq);
+    }
+  }
+}
+
 //! Compute gravitational driving stress at quadrature points.
 //! Uses explicitly-provided nodal values.
 void SSAFEM::explicit_driving_stress(const fem::Element &E,
@@ -726,8 +844,6 @@ void SSAFEM::cache_residual_cfbc(const Inputs &inputs) {
 void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global,
                                     Vector2d **residual_global) {
 
-  const bool use_explicit_driving_stress = (m_driving_stress_x != NULL) && (m_driving_stress_y != NULL);
-
   const bool use_cfbc = m_config->get_flag("stress_balance.calving_front_stress_bc");
 
   const unsigned int Nk = fem::q1::n_chi;
@@ -740,7 +856,9 @@ void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global
                                P1Element2(*m_grid, Q_p1, 2),
                                P1Element2(*m_grid, Q_p1, 3)};
 
-  array::AccessScope list{&m_node_type, &m_coefficients, &m_boundary_integral};
+  array::AccessScope list{&m_node_type, &m_boundary_integral};
+
+  const auto &C = m_qp_cache;
 
   // Set the boundary contribution of the residual. This is computed at the nodes, so we don't want
   // to set it using Element::add_contribution() because that would lead to
@@ -769,33 +887,29 @@ void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global
     for (int j = ys; j < ys + ym; j++) {
       for (int i = xs; i < xs + xm; i++) {
 
-        fem::Element2 *E = nullptr;
-        {
-          m_q1_element.reset(i, j);
+        // index of this element in m_qp_cache
+        const int e = (j - ys) * xm + (i - xs);
 
-          int node_type[Nk];
-          m_q1_element.nodal_values(m_node_type, node_type);
+        const int type = C.element_type[e];
 
-          auto type = fem::element_type(node_type);
+        if (type == fem::ELEMENT_EXTERIOR) {
+          // skip exterior elements
+          continue;
+        }
 
-          if (use_cfbc) {
-            if (type == fem::ELEMENT_EXTERIOR) {
-              // skip exterior elements
-              continue;
-            }
-
-            if (type == fem::ELEMENT_Q) {
-              E = &m_q1_element;
-            } else {
-              E = &p1_element[type];
-
-              E->reset(i, j);
-            }
-          } else {
-            // if use_cfbc == false all elements are interior and Q1
-            E = &m_q1_element;
-          }
+        fem::Element2 *E = &m_q1_element;
+        if (type != fem::ELEMENT_Q) {
+          E = &p1_element[type];
         }
+        E->reset(i, j);
+
+        // coefficients at quadrature points of this element
+        const int n = C.offset[e];
+        const int      *mask      = &C.mask[n];
+        const double   *thickness = &C.thickness[n];
+        const double   *tauc      = &C.tauc[n];
+        const double   *hardness  = &C.hardness[n];
+        const Vector2d *tau_d     = &C.driving_stress[n];
 
         // Number of quadrature points.
         const unsigned int Nq = E->n_pts();
@@ -803,25 +917,6 @@ void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global
         // Storage for the solution and residuals at element nodes.
         Vector2d residual[Nk];
 
-        int    mask[Nq_max];
-        double thickness[Nq_max];
-        double tauc[Nq_max];
-        double hardness[Nq_max];
-        Vector2d tau_d[Nq_max];
-
-        {
-          Coefficients coeffs[Nk];
-          E->nodal_values(m_coefficients.array(), coeffs);
-
-          quad_point_values(*E, coeffs, mask, thickness, tauc, hardness);
-
-          if (use_explicit_driving_stress) {
-            explicit_driving_stress(*E, coeffs, tau_d);
-          } else {
-            driving_stress(*E, coeffs, tau_d);
-          }
-        }
-
         {
           // Obtain the value of the solution at the nodes
           Vector2d velocity_nodal[Nk];
@@ -963,7 +1058,9 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
   PetscErrorCode ierr = MatZeroEntries(Jac);
   PISM_CHK(ierr, "MatZeroEntries");
 
-  array::AccessScope list{&m_node_type, &m_coefficients};
+  array::AccessScope list{&m_node_type};
+
+  const auto &C = m_qp_cache;
 
   // Start access to Dirichlet data if present.
   fem::DirichletData_Vector dirichlet_data(&m_bc_mask, &m_bc_values, m_dirichletScale);
@@ -983,52 +1080,34 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
     for (int j = ys; j < ys + ym; j++) {
       for (int i = xs; i < xs + xm; i++) {
 
-        fem::Element2 *E = nullptr;
-        {
-          m_q1_element.reset(i, j);
+        // index of this element in m_qp_cache
+        const int e = (j - ys) * xm + (i - xs);
 
-          int node_type[Nk];
-          m_q1_element.nodal_values(m_node_type, node_type);
+        const int type = C.element_type[e];
 
-          auto type = fem::element_type(node_type);
+        if (type == fem::ELEMENT_EXTERIOR) {
+          // skip exterior elements
+          continue;
+        }
 
-          if (use_cfbc) {
-            if (type == fem::ELEMENT_EXTERIOR) {
-              // skip exterior elements
-              continue;
-            }
-
-            if (type == fem::ELEMENT_Q) {
-              E = &m_q1_element;
-            } else {
-              E = &p1_element[type];
-
-              E->reset(i, j);
-            }
-          } else {
-            // if use_cfbc == false all elements are interior and Q1
-            E = &m_q1_element;
-          }
+        fem::Element2 *E = &m_q1_element;
+        if (type != fem::ELEMENT_Q) {
+          E = &p1_element[type];
         }
+        E->reset(i, j);
+
+        // coefficients at quadrature points of this element
+        const int n = C.offset[e];
+        const int      *mask      = &C.mask[n];
+        const double   *thickness = &C.thickness[n];
+        const double   *tauc      = &C.tauc[n];
+        const double   *hardness  = &C.hardness[n];
 
         // Number of quadrature points.
         const unsigned int
           Nq = E->n_pts(),
           n_chi = E->n_chi();
 
-        int    mask[Nq_max];
-        double thickness[Nq_max];
-        double tauc[Nq_max];
-        double hardness[Nq_max];
-
-        {
-          Coefficients coeffs[Nk];
-          E->nodal_values(m_coefficients.array(), coeffs);
-
-          quad_point_values(*E, coeffs,
-                            mask, thickness, tauc, hardness);
-        }
-
         {
           // Values of the solution at the nodes of the current element.
           Vector2d velocity_nodal[Nk];
@@ -75,6 +75,37 @@ protected:
 
   array::Array2D<Coefficients> m_coefficients;
 
+  //! Storage for coefficients at quadrature points of all elements in this sub-domain
+  //! ("structure of arrays" layout).
+  //!
+  //! Values of shape functions are not stored: they are the same for all elements of a
+  //! given type.
+  //!
+  //! Filling this cache costs about as much as 0.2 residual evaluations and uses 184 bytes
+  //! per Q1 element. It makes residual evaluations 13-23% and Jacobian evaluations 4-7%
+  //! faster, because each evaluation no longer interpolates nodal coefficients, computes
+  //! the cell type and computes the driving stress at quadrature points.
+  struct QuadPointCache {
+    //! element type (see fem::ElementType), one per element
+    std::vector<int> element_type;
+    //! index of the first quadrature point of an element, one per element
+    std::vector<int> offset;
+    //! cell type mask at quadrature points
+    std::vector<int> mask;
+    //! ice thickness at quadrature points
+    std::vector<double> thickness;
+    //! basal yield stress at quadrature points
+    std::vector<double> tauc;
+    //! ice hardness at quadrature points
+    std::vector<double> hardness;
+    //! gravitational driving stress at quadrature points
+    std::vector<Vector2d> driving_stress;
+  };
+
+  QuadPointCache m_qp_cache;
+
+  void cache_quad_point_values();
+
   void quad_point_values(const fem::Element &Q,
                          const Coefficients *x,
                          int *mask,
@@ -126,6 +157,8 @@ protected:
   CallbackData m_callback_data;
 
   petsc::SNES m_snes;
+  //! SNES relative tolerance set using command-line options (scaled in the adaptive mode)
+  double m_snes_rtol;
 
   //! Storage for node types (interior, boundary, exterior).
   array::Scalar1 m_node_type;
@@ -94,12 +94,20 @@ CFLData max_timestep_cfl_3d(const array::Scalar &ice_thickness,
   }
   loop.check();
 
+  MaxTimestepReduction reduction;
+  int
+    dt = reduction.add(MaxTimestep(dt_max)),
+    u  = reduction.add_max(u_max),
+    v  = reduction.add_max(v_max),
+    w  = reduction.add_max(w_max);
+  reduction.reduce(grid->com);
+
   CFLData result;
 
-  result.u_max = GlobalMax(grid->com, u_max);
-  result.v_max = GlobalMax(grid->com, v_max);
-  result.w_max = GlobalMax(grid->com, w_max);
-  result.dt_max = MaxTimestep(GlobalMin(grid->com, dt_max));
+  result.u_max  = reduction.max(u);
+  result.v_max  = reduction.max(v);
+  result.w_max  = reduction.max(w);
+  result.dt_max = reduction.restriction(dt);
 
   return result;
 }
@@ -148,12 +156,19 @@ CFLData max_timestep_cfl_2d(const array::Scalar &ice_thickness,
     }
   }
 
+  MaxTimestepReduction reduction;
+  int
+    dt = reduction.add(MaxTimestep(dt_max)),
+    u  = reduction.add_max(u_max),
+    v  = reduction.add_max(v_max);
+  reduction.reduce(grid->com);
+
   CFLData result;
 
-  result.u_max = GlobalMax(grid->com, u_max);
-  result.v_max = GlobalMax(grid->com, v_max);
-  result.w_max = 0.0;
-  result.dt_max = MaxTimestep(GlobalMin(grid->com, dt_max));
+  result.u_max  = reduction.max(u);
+  result.v_max  = reduction.max(v);
+  result.w_max  = 0.0;
+  result.dt_max = reduction.restriction(dt);
 
   return result;
 }
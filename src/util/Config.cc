@@ -37,6 +37,20 @@ NetCDFConfig::NetCDFConfig(MPI_Comm com, const std::string &name, units::System:
 NetCDFConfig::~NetCDFConfig() {
 }
 
+/*!
+ * Copy all parameters from `other`.
+ *
+ * This is cheaper than reading the same configuration file again and makes it possible to
+ * create several copies of a configuration database (e.g. one per ensemble member) using
+ * different communicators.
+ */
+void NetCDFConfig::copy_from(const NetCDFConfig &other) {
+  m_data            = other.m_data;
+  m_config_filename = other.m_config_filename;
+
+  copy_state(other);
+}
+
 bool NetCDFConfig::is_set_impl(const std::string &name) const {
   return m_data.has_attribute(name);
 }
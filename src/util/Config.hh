@@ -36,6 +36,8 @@ public:
   NetCDFConfig(MPI_Comm com, const std::string &name, units::System::Ptr unit_system);
   ~NetCDFConfig();
 
+  // Copy all parameters (including their metadata) from `other`.
+  void copy_from(const NetCDFConfig &other);
 protected:
   void read_impl(const File &nc);
   void write_impl(const File &nc) const;
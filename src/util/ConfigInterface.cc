@@ -54,8 +54,33 @@ struct Config::Impl {
   //! @brief Set of parameters used in a run. Used to warn about parameters that were set but were
   //! not used.
   std::set<std::string> parameters_used;
+
+  //! Incremented every time a parameter is modified. Used by ConfigNumber and ConfigFlag.
+  int state_counter = 0;
+
+  //! Unit converters used by get_number() and get_numbers(), indexed by "input units" and
+  //! "output units". Creating a converter is much more expensive than using one.
+  std::map<std::pair<std::string, std::string>, std::shared_ptr<units::Converter> > converters;
+
+  const units::Converter &converter(const std::string &input_units,
+                                    const std::string &output_units);
 };
 
+const units::Converter &Config::Impl::converter(const std::string &input_units,
+                                                const std::string &output_units) {
+  auto key = std::make_pair(input_units, output_units);
+
+  auto c = converters.find(key);
+  if (c != converters.end()) {
+    return *c->second;
+  }
+
+  auto result = std::make_shared<units::Converter>(unit_system, input_units, output_units);
+  converters[key] = result;
+
+  return *result;
+}
+
 Config::Config(units::System::Ptr system)
   : m_impl(new Impl(system)) {
   // empty
@@ -73,6 +98,7 @@ void Config::read(MPI_Comm com, const std::string &filename) {
 
 void Config::read(const File &file) {
   this->read_impl(file);
+  m_impl->state_counter += 1;
 
   m_impl->filename = file.filename();
 }
@@ -90,6 +116,12 @@ void Config::write(MPI_Comm com, const std::string &filename, bool append) const
   this->write(file);
 }
 
+void Config::copy_state(const Config &other) {
+  m_impl->filename               = other.m_impl->filename;
+  m_impl->parameters_set_by_user = other.m_impl->parameters_set_by_user;
+  m_impl->state_counter += 1;
+}
+
 //! \brief Returns the name of the file used to initialize the database.
 std::string Config::filename() const {
   return m_impl->filename;
@@ -159,6 +191,16 @@ const std::set<std::string>& Config::parameters_used() const {
   return m_impl->parameters_used;
 }
 
+/*!
+ * Return the number of modifications of this configuration database.
+ *
+ * Used to detect if cached parameter values (see ConfigNumber and ConfigFlag) are out of
+ * date.
+ */
+int Config::state_counter() const {
+  return m_impl->state_counter;
+}
+
 bool Config::is_set(const std::string &name) const {
   return this->is_set_impl(name);
 }
@@ -181,7 +223,7 @@ double Config::get_number(const std::string &name,
   std::string input_units = this->units(name);
 
   try {
-    return units::convert(m_impl->unit_system, value, input_units, units);
+    return m_impl->converter(input_units, units)(value);
   } catch (RuntimeError &e) {
     e.add_context("converting \"%s\" from \"%s\" to \"%s\"",
                   name.c_str(), input_units.c_str(), units.c_str());
@@ -203,7 +245,7 @@ std::vector<double> Config::get_numbers(const std::string &name,
   auto input_units = this->units(name);
 
   try {
-    units::Converter converter(m_impl->unit_system, input_units, units);
+    const auto &converter = m_impl->converter(input_units, units);
     for (unsigned int k = 0; k < value.size(); ++k) {
       value[k] = converter(value[k]);
     }
@@ -230,6 +272,7 @@ void Config::set_number(const std::string &name, double value,
   }
 
   this->set_number_impl(name, value);
+  m_impl->state_counter += 1;
 }
 
 void Config::set_numbers(const std::string &name,
@@ -248,6 +291,7 @@ void Config::set_numbers(const std::string &name,
   }
 
   this->set_numbers_impl(name, values);
+  m_impl->state_counter += 1;
 }
 
 Config::Strings Config::all_strings() const {
@@ -277,6 +321,7 @@ void Config::set_string(const std::string &name,
   }
 
   this->set_string_impl(name, value);
+  m_impl->state_counter += 1;
 }
 
 Config::Flags Config::all_flags() const {
@@ -305,6 +350,7 @@ void Config::set_flag(const std::string& name, bool value,
   }
 
   this->set_flag_impl(name, value);
+  m_impl->state_counter += 1;
 }
 
 static bool special_parameter(const std::string &name) {
@@ -774,6 +820,31 @@ void set_config_from_options(units::System::Ptr unit_system, Config &config) {
   }
 }
 
+ConfigNumber::ConfigNumber(Config::ConstPtr config, const std::string &name,
+                           const std::string &units)
+  : m_config(config), m_name(name), m_units(units), m_state_counter(-1), m_value(0.0) {
+  update();
+}
+
+void ConfigNumber::update() const {
+  if (m_units.empty()) {
+    m_value = m_config->get_number(m_name);
+  } else {
+    m_value = m_config->get_number(m_name, m_units);
+  }
+  m_state_counter = m_config->state_counter();
+}
+
+ConfigFlag::ConfigFlag(Config::ConstPtr config, const std::string &name)
+  : m_config(config), m_name(name), m_state_counter(-1), m_value(false) {
+  update();
+}
+
+void ConfigFlag::update() const {
+  m_value = m_config->get_flag(m_name);
+  m_state_counter = m_config->state_counter();
+}
+
 //! Create a configuration database using command-line options.
 Config::Ptr config_from_options(MPI_Comm com, const Logger &log, units::System::Ptr unit_system) {
 
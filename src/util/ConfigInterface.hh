@@ -87,6 +87,8 @@ public:
 
   bool is_set(const std::string &name) const;
 
+  int state_counter() const;
+
   // doubles
   typedef std::map<std::string, std::vector<double> > Doubles;
   Doubles all_doubles() const;
@@ -125,6 +127,9 @@ public:
   std::string choices(const std::string &parameter) const;
   // Implementations
 protected:
+  // Copy the file name and the list of parameters set by the user from `other`.
+  void copy_state(const Config &other);
+
   virtual void read_impl(const File &nc) = 0;
   virtual void write_impl(const File &nc) const = 0;
 
@@ -169,6 +174,54 @@ private:
   Config::ConstPtr m_config;
 };
 
+//! Typed handle providing fast access to a numerical parameter.
+/*!
+ * Looks up the parameter (converting it to `units` if they are not empty) when created
+ * and then only if the configuration database was modified since the last lookup. Use it
+ * in code that runs every time step.
+ */
+class ConfigNumber {
+public:
+  ConfigNumber(Config::ConstPtr config, const std::string &name, const std::string &units = "");
+
+  double value() const {
+    if (m_config->state_counter() != m_state_counter) {
+      update();
+    }
+    return m_value;
+  }
+private:
+  void update() const;
+
+  Config::ConstPtr m_config;
+  std::string m_name;
+  std::string m_units;
+
+  mutable int m_state_counter;
+  mutable double m_value;
+};
+
+//! Typed handle providing fast access to a flag. See ConfigNumber.
+class ConfigFlag {
+public:
+  ConfigFlag(Config::ConstPtr config, const std::string &name);
+
+  bool value() const {
+    if (m_config->state_counter() != m_state_counter) {
+      update();
+    }
+    return m_value;
+  }
+private:
+  void update() const;
+
+  Config::ConstPtr m_config;
+  std::string m_name;
+
+  mutable int m_state_counter;
+  mutable bool m_value;
+};
+
 Config::Ptr config_from_options(MPI_Comm com, const Logger &log, units::System::Ptr unit_system);
 
 //! Set configuration parameters using command-line options.
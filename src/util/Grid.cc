@@ -37,6 +37,8 @@
 #include "pism/util/pism_options.hh"
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/io/IO_Flags.hh"
+#include "pism/util/io/LocalInterpCtx.hh"
+#include "pism/util/interpolation.hh"
 
 #if (Pism_USE_PIO == 1)
 // Why do I need this???
@@ -121,6 +123,13 @@ struct Grid::Impl {
 
   //! ParallelIO I/O decompositions.
   std::map<std::array<int, 2>, int> io_decompositions;
+  //! Interpolation contexts used to regrid from input grids, indexed by the interpolation
+  //! type, sizes and extents of input grid coordinates and internal vertical levels.
+  struct CachedInterpCtx {
+    std::vector<double> x, y;
+    std::shared_ptr<const LocalInterpCtx> lic;
+  };
+  std::map<std::vector<double>, CachedInterpCtx> interpolation_contexts;
 };
 
 Grid::Impl::Impl(std::shared_ptr<const Context> context)
@@ -670,6 +679,46 @@ std::shared_ptr<petsc::DM> Grid::get_dm(unsigned int dm_dof, unsigned int stenci
   return m_impl->dms[key].lock();
 }
 
+//! Return the interpolation context used to regrid from `input_grid` to this grid.
+/*!
+ * Most variables read during bootstrapping and regridding use the same input grid, so
+ * interpolation contexts (indices and weights) are computed once per input grid and
+ * re-used.
+ */
+LocalInterpCtx Grid::interpolation_context(const grid::InputGridInfo &input_grid,
+                                           const std::vector<double> &z_internal,
+                                           InterpolationType type) const {
+  const auto &x = input_grid.x;
+  const auto &y = input_grid.y;
+  const auto &z = input_grid.z;
+
+  std::vector<double> key = { (double)type, (double)x.size(), (double)y.size() };
+  if (not x.empty()) {
+    key.insert(key.end(), { x.front(), x.back() });
+  }
+  if (not y.empty()) {
+    key.insert(key.end(), { y.front(), y.back() });
+  }
+  key.push_back((double)z.size());
+  key.insert(key.end(), z.begin(), z.end());
+  key.push_back((double)z_internal.size());
+  key.insert(key.end(), z_internal.begin(), z_internal.end());
+
+  auto &entry = m_impl->interpolation_contexts[key];
+
+  if (entry.lic == nullptr or entry.x != x or entry.y != y) {
+    entry.x   = x;
+    entry.y   = y;
+    entry.lic = std::make_shared<LocalInterpCtx>(input_grid, *this, z_internal, type);
+  }
+
+  LocalInterpCtx result = *entry.lic;
+  // the number of records may differ between variables using the same grid
+  result.start[T_AXIS] = (int)input_grid.t_len - 1;
+
+  return result;
+}
+
 //! Return grid periodicity.
 grid::Periodicity Grid::periodicity() const {
   return m_impl->periodicity;
@@ -858,6 +907,16 @@ int Grid::max_patch_size() const {
   return m_impl->max_patch_size;
 }
 
+//! Lengths (in the x-direction) of processor sub-domains.
+std::vector<unsigned int> Grid::procs_x() const {
+  return {m_impl->procs_x.begin(), m_impl->procs_x.end()};
+}
+
+//! Lengths (in the y-direction) of processor sub-domains.
+std::vector<unsigned int> Grid::procs_y() const {
+  return {m_impl->procs_y.begin(), m_impl->procs_y.end()};
+}
+
 
 namespace grid {
 //! \brief Set the vertical levels in the ice according to values in `Mz` (number of levels), `Lz`
@@ -35,6 +35,8 @@ class Context;
 class File;
 class Logger;
 class MappingInfo;
+class LocalInterpCtx;
+enum InterpolationType : int;
 class Vars;
 
 namespace petsc {
@@ -298,6 +300,10 @@ public:
 
   std::shared_ptr<petsc::DM> get_dm(unsigned int dm_dof, unsigned int stencil_width) const;
 
+  LocalInterpCtx interpolation_context(const grid::InputGridInfo &input_grid,
+                                       const std::vector<double> &z_internal,
+                                       InterpolationType type) const;
+
   void report_parameters() const;
 
   void compute_point_neighbors(double X, double Y,
@@ -310,6 +316,9 @@ public:
 
   int max_patch_size() const;
 
+  std::vector<unsigned int> procs_x() const;
+  std::vector<unsigned int> procs_y() const;
+
   std::shared_ptr<const Context> ctx() const;
 
   int xs() const;
@@ -20,6 +20,9 @@
 #include "pism/util/MaxTimestep.hh"
 
 #include <cassert>
+#include <limits>
+
+#include "pism/util/pism_utilities.hh"
 
 namespace pism {
 
@@ -80,4 +83,67 @@ bool operator>(const MaxTimestep &a, const MaxTimestep &b) {
   return (not (a == b)) and (not (a < b));
 }
 
+int MaxTimestepReduction::add(const MaxTimestep &local) {
+  m_restrictions.push_back(local);
+  return static_cast<int>(m_restrictions.size()) - 1;
+}
+
+int MaxTimestepReduction::add_max(double local) {
+  m_values.push_back(local);
+  return static_cast<int>(m_values.size()) - 1;
+}
+
+/*!
+ * Replace all local values with global ones.
+ *
+ * Packs negated time step lengths and values that need a global maximum into one array so
+ * that a single `MPI_MAX` reduction computes all of them.
+ */
+void MaxTimestepReduction::reduce(MPI_Comm com) {
+  const double infinite = -std::numeric_limits<double>::infinity();
+
+  const size_t N = m_restrictions.size(), M = m_values.size();
+
+  if (N + M == 0) {
+    return;
+  }
+
+  std::vector<double> local(N + M), global(N + M);
+
+  for (size_t k = 0; k < N; ++k) {
+    const auto &dt = m_restrictions[k];
+    local[k] = dt.finite() ? -dt.value() : infinite;
+  }
+  for (size_t k = 0; k < M; ++k) {
+    local[N + k] = m_values[k];
+  }
+
+  GlobalMax(com, local.data(), global.data(), static_cast<int>(N + M));
+
+  for (size_t k = 0; k < N; ++k) {
+    auto description = m_restrictions[k].description();
+
+    if (global[k] == infinite) {
+      m_restrictions[k] = MaxTimestep(description);
+    } else {
+      m_restrictions[k] = MaxTimestep(-global[k], description);
+    }
+  }
+  for (size_t k = 0; k < M; ++k) {
+    m_values[k] = global[N + k];
+  }
+}
+
+MaxTimestep MaxTimestepReduction::restriction(int index) const {
+  return m_restrictions.at(index);
+}
+
+double MaxTimestepReduction::max(int index) const {
+  return m_values.at(index);
+}
+
+int MaxTimestepReduction::n_restrictions() const {
+  return static_cast<int>(m_restrictions.size());
+}
+
 } // end of namespace pism
@@ -21,6 +21,9 @@
 #define PISM_MAXTIMESTEP_HH
 
 #include <string>
+#include <vector>
+
+#include <mpi.h>
 
 namespace pism {
 
@@ -62,6 +65,33 @@ bool operator<(const MaxTimestep &a, const MaxTimestep &b);
 //! Equality operator for MaxTimestep.
 bool operator==(const MaxTimestep &a, const MaxTimestep &b);
 
+//! @brief Combines global reductions needed to compute several time step restrictions
+//! into one `MPI_Allreduce` call.
+/*!
+ * Callers add *local* time step restrictions (computed using the current sub-domain)
+ * and local values that need a global maximum (e.g. maximum speeds used for reporting),
+ * then call reduce(). All ranks have to add the same quantities in the same order.
+ *
+ * Descriptions of time step restrictions are preserved.
+ */
+class MaxTimestepReduction {
+public:
+  //! Add a local time step restriction. Returns its index.
+  int add(const MaxTimestep &local);
+  //! Add a local value that should be replaced by its global maximum. Returns its index.
+  int add_max(double local);
+
+  void reduce(MPI_Comm com);
+
+  MaxTimestep restriction(int index) const;
+  double max(int index) const;
+
+  int n_restrictions() const;
+private:
+  std::vector<MaxTimestep> m_restrictions;
+  std::vector<double> m_values;
+};
+
 } // end of namespace pism
 
 #endif /* PISM_MAXTIMESTEP_HH */
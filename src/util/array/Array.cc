@@ -16,10 +16,12 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
+#include <algorithm>
 #include <cassert>
 
 #include <cmath>
 #include <cstddef>
+#include <limits>
 #include <petscdraw.h>
 #include <string>
 
@@ -105,6 +107,10 @@ Array::Array(std::shared_ptr<const Grid> grid,
 Array::~Array() {
   assert(m_impl->access_counter == 0);
 
+  if (m_impl->shared_vec and m_impl->shared_vec->owner == m_impl) {
+    m_impl->shared_vec->owner = nullptr;
+  }
+
   if (m_impl->bsearch_accel != nullptr) {
     gsl_interp_accel_free(m_impl->bsearch_accel);
     m_impl->bsearch_accel = nullptr;
@@ -235,7 +241,20 @@ static NormType int_to_normtype(int input) {
 void Array::add(double alpha, const Array &x) {
   checkCompatibility("add", x);
 
-  PetscErrorCode ierr = VecAXPY(vec(), alpha, x.vec());
+  PetscErrorCode ierr = 0;
+  if (m_impl->shared_vec and m_impl->shared_vec == x.m_impl->shared_vec) {
+    // compressed arrays `x` and `this` cannot use the shared Vec at the same time
+    petsc::Vec tmp;
+    ierr = VecDuplicate(x.vec(), tmp.rawptr());
+    PISM_CHK(ierr, "VecDuplicate");
+
+    ierr = VecCopy(x.vec(), tmp);
+    PISM_CHK(ierr, "VecCopy");
+
+    ierr = VecAXPY(vec(), alpha, tmp);
+  } else {
+    ierr = VecAXPY(vec(), alpha, x.vec());
+  }
   PISM_CHK(ierr, "VecAXPY");
 
   inc_state_counter();          // mark as modified
@@ -336,20 +355,243 @@ unsigned int Array::stencil_width() const {
   return 0;
 }
 
+void create_vec(petsc::DM &dm, bool ghosted, petsc::Vec &result) {
+  PetscErrorCode ierr = 0;
+  if (ghosted) {
+    ierr = DMCreateLocalVector(dm, result.rawptr());
+    PISM_CHK(ierr, "DMCreateLocalVector");
+  } else {
+    ierr = DMCreateGlobalVector(dm, result.rawptr());
+    PISM_CHK(ierr, "DMCreateGlobalVector");
+  }
+}
+
+/*!
+ * Returns the PETSc Vec containing values of this array.
+ *
+ * A compressed array (see Array3D::set_compression()) does not have a Vec of its own.
+ * Its values are unpacked into a Vec shared by all compressed arrays with the same
+ * layout. They are packed again when some other array needs this Vec or when this array
+ * is accessed using an AccessScope.
+ */
 petsc::Vec &Array::vec() const {
-  if (m_impl->v.get() == nullptr) {
-    PetscErrorCode ierr = 0;
-    if (m_impl->ghosted) {
-      ierr = DMCreateLocalVector(*dm(), m_impl->v.rawptr());
-      PISM_CHK(ierr, "DMCreateLocalVector");
-    } else {
-      ierr = DMCreateGlobalVector(*dm(), m_impl->v.rawptr());
-      PISM_CHK(ierr, "DMCreateGlobalVector");
+  if (m_impl->compression != COMPRESSION_NONE) {
+    auto &shared = *m_impl->shared_vec;
+
+    if (shared.owner != m_impl) {
+      m_impl->flush_columns();
+
+      if (shared.owner != nullptr) {
+        shared.owner->release_vec();
+      }
+
+      petsc::VecArray x(shared.v);
+      m_impl->unpack(x.get());
+      shared.owner = m_impl;
     }
+    return shared.v;
+  }
+
+  if (m_impl->v.get() == nullptr) {
+    create_vec(*dm(), m_impl->ghosted, m_impl->v);
   }
   return m_impl->v;
 }
 
+//! Get the Vec shared by compressed arrays that use the DM `dm`.
+std::shared_ptr<Array::Impl::SharedVec> Array::Impl::get_shared_vec(petsc::DM &dm,
+                                                                    bool ghosted) {
+  // Note: arrays using a SharedVec keep the DM alive, so a DM address is not re-used
+  // while the corresponding SharedVec exists.
+  static std::map<std::pair<::DM, bool>, std::weak_ptr<SharedVec> > vecs;
+
+  auto &entry = vecs[{ dm.get(), ghosted }];
+
+  auto result = entry.lock();
+  if (not result) {
+    result = std::make_shared<SharedVec>();
+    create_vec(dm, ghosted, result->v);
+    entry = result;
+  }
+  return result;
+}
+
+//! Number of values in a column (including all degrees of freedom).
+size_t Array::Impl::column_size() const {
+  return dof * zlevels.size();
+}
+
+//! Index of the column `(i, j)` in packed storage.
+size_t Array::Impl::column_index(int i, int j) const {
+  return (j - packed_ys) * packed_xm + (i - packed_xs);
+}
+
+//! Returns a pointer to values in the column `(i, j)` unpacked into double precision.
+/*!
+ * Keeps `columns.size()` most recently used columns. Columns modified by the caller are
+ * packed when they are evicted and at the end of the outermost access scope.
+ *
+ * With `access == COLUMN_OVERWRITE` the caller has to set all values in the column, so
+ * packed values are not unpacked.
+ */
+double *Array::Impl::column(int i, int j, ColumnAccess access) {
+  if (shared_vec->owner == this) {
+    release_vec();
+  }
+
+  ++column_counter;
+
+  Column *slot = nullptr;
+  for (auto &c : columns) {
+    if (c.valid and c.i == i and c.j == j) {
+      c.last_use = column_counter;
+      c.modified = c.modified or access != COLUMN_READ;
+      return c.values.data();
+    }
+
+    // unused columns have last_use == 0
+    if (slot == nullptr or c.last_use < slot->last_use) {
+      slot = &c;
+    }
+  }
+
+  if (slot->valid and slot->modified) {
+    pack_column(column_index(slot->i, slot->j), slot->values.data());
+  }
+
+  if (access != COLUMN_OVERWRITE) {
+    unpack_column(column_index(i, j), slot->values.data());
+  }
+
+  slot->i        = i;
+  slot->j        = j;
+  slot->valid    = true;
+  slot->modified = access != COLUMN_READ;
+  slot->last_use = column_counter;
+
+  return slot->values.data();
+}
+
+//! Pack modified columns and discard all unpacked columns.
+void Array::Impl::flush_columns() {
+  for (auto &c : columns) {
+    if (c.valid and c.modified) {
+      pack_column(column_index(c.i, c.j), c.values.data());
+    }
+    c.valid    = false;
+    c.modified = false;
+    c.last_use = 0;
+  }
+}
+
+//! Pack values stored in the shared Vec (if any) so that it can be used by another array.
+void Array::Impl::release_vec() {
+  if (shared_vec and shared_vec->owner == this) {
+    petsc::VecArray x(shared_vec->v);
+    pack(x.get());
+    shared_vec->owner = nullptr;
+  }
+}
+
+//! Pack all columns (`x` uses the layout of the PETSc Vec).
+void Array::Impl::pack(const double *x) {
+  const size_t N = column_size(), n_columns = packed_xm * packed_ym;
+  for (size_t c = 0; c < n_columns; ++c) {
+    pack_column(c, &x[c * N]);
+  }
+}
+
+//! Unpack all columns (`x` uses the layout of the PETSc Vec).
+void Array::Impl::unpack(double *x) const {
+  const size_t N = column_size(), n_columns = packed_xm * packed_ym;
+  for (size_t c = 0; c < n_columns; ++c) {
+    unpack_column(c, &x[c * N]);
+  }
+}
+
+//! Store values in the column number `c` using reduced precision.
+/*!
+ * With COMPRESSION_FLOAT32 each value is stored as a `float`.
+ *
+ * With COMPRESSION_INT16 each column (all values at a grid point) is stored as 16-bit
+ * integers scaled to cover the range of values in this column. The maximum error is
+ * `(max - min) / 131070`, where `max` and `min` are column extremes. Values restored
+ * from packed storage are not packed again: this avoids accumulating rounding errors.
+ */
+void Array::Impl::pack_column(size_t c, const double *x) {
+  const size_t N = column_size();
+
+  if (compression == COMPRESSION_FLOAT32) {
+    float *packed = &packed_float[c * N];
+    for (size_t k = 0; k < N; ++k) {
+      packed[k] = static_cast<float>(x[k]);
+    }
+    return;
+  }
+
+  uint16_t *packed = &packed_int16[c * N];
+
+  {
+    const double offset = column_offset[c], scale = column_scale[c];
+
+    bool unchanged = true;
+    for (size_t k = 0; k < N and unchanged; ++k) {
+      unchanged = (x[k] == offset + scale * packed[k]);
+    }
+
+    if (unchanged) {
+      return;
+    }
+  }
+
+  const double max_int = std::numeric_limits<uint16_t>::max();
+
+  double min = x[0], max = x[0];
+  for (size_t k = 1; k < N; ++k) {
+    min = std::min(min, x[k]);
+    max = std::max(max, x[k]);
+  }
+
+  double scale = (max - min) / max_int;
+
+  column_offset[c] = min;
+  column_scale[c]  = scale;
+
+  for (size_t k = 0; k < N; ++k) {
+    packed[k] = scale > 0.0 ?
+                    static_cast<uint16_t>(std::min(std::round((x[k] - min) / scale), max_int)) :
+                    0;
+  }
+}
+
+//! Restore values in the column number `c` stored by pack_column().
+void Array::Impl::unpack_column(size_t c, double *x) const {
+  const size_t N = column_size();
+
+  if (compression == COMPRESSION_FLOAT32) {
+    const float *packed = &packed_float[c * N];
+    for (size_t k = 0; k < N; ++k) {
+      x[k] = packed[k];
+    }
+    return;
+  }
+
+  const uint16_t *packed = &packed_int16[c * N];
+  const double offset = column_offset[c], scale = column_scale[c];
+  for (size_t k = 0; k < N; ++k) {
+    x[k] = offset + scale * packed[k];
+  }
+}
+
+//! Free packed storage and unpacked columns.
+void Array::Impl::free_packed() {
+  std::vector<float>().swap(packed_float);
+  std::vector<uint16_t>().swap(packed_int16);
+  std::vector<double>().swap(column_offset);
+  std::vector<double>().swap(column_scale);
+  std::vector<Column>().swap(columns);
+}
+
 std::shared_ptr<petsc::DM> Array::dm() const {
   if (m_impl->da == nullptr) {
     // dof > 1 for vector, staggered grid 2D fields, etc. In this case zlevels.size() ==
@@ -450,7 +692,7 @@ void Array::regrid_impl(const File &file, io::Default default_value) {
       // internal vertical (Z) grid.
       io::check_input_grid(input_grid, *grid(), {0.0});
 
-      LocalInterpCtx lic(input_grid, *grid(), levels(), m_impl->interpolation_type);
+      auto lic = grid()->interpolation_context(input_grid, levels(), m_impl->interpolation_type);
 
       // Note: this call will read the last time record (the index is set in `lic` based on
       // info in `input_grid`).
@@ -565,8 +807,12 @@ void Array::write_impl(const File &file) const {
   auto log = m_impl->grid->ctx()->log();
   auto time = timestamp(m_impl->grid->com);
 
-  // The simplest case:
+  // write throughput is reported at verbosity 3 (note that get_time() is collective)
+  bool report_throughput = log->get_threshold() >= 3;
+  double start = report_throughput ? get_time(m_impl->grid->com) : 0.0;
+
   if (ndof() == 1) {
+    // The simplest case:
     log->message(3, "[%s] Writing %s...\n",
                  time.c_str(), metadata(0).get_name().c_str());
 
@@ -582,24 +828,40 @@ void Array::write_impl(const File &file) const {
       petsc::VecArray v_array(vec());
       io::write_spatial_variable(metadata(0), *grid(), file, v_array.get());
     }
-    return;
+  } else {
+    // Get the dof=1, stencil_width=0 DMDA (components are always scalar
+    // and we just need a global Vec):
+    auto da2 = m_impl->grid->get_dm(1, 0);
+
+    // a temporary one-component vector, distributed across processors
+    // the same way v is
+    petsc::TemporaryGlobalVec tmp(da2);
+
+    for (unsigned int j = 0; j < ndof(); ++j) {
+      get_dof(da2, tmp, j);
+
+      petsc::VecArray tmp_array(tmp);
+      log->message(3, "[%s] Writing %s...\n",
+                   time.c_str(), metadata(j).get_name().c_str());
+      io::write_spatial_variable(metadata(j), *grid(), file, tmp_array.get());
+    }
   }
 
-  // Get the dof=1, stencil_width=0 DMDA (components are always scalar
-  // and we just need a global Vec):
-  auto da2 = m_impl->grid->get_dm(1, 0);
+  // report write throughput (useful for 3D fields)
+  if (report_throughput) {
+    double elapsed = get_time(m_impl->grid->com) - start;
 
-  // a temporary one-component vector, distributed across processors
-  // the same way v is
-  petsc::TemporaryGlobalVec tmp(da2);
+    // sizes of all components in the file, in bytes
+    size_t value_size = 0;
+    for (unsigned int j = 0; j < ndof(); ++j) {
+      value_size += io::type_size(file.variable_type(metadata(j).get_name()));
+    }
 
-  for (unsigned int j = 0; j < ndof(); ++j) {
-    get_dof(da2, tmp, j);
+    double MiB = (1.0 * grid()->Mx() * grid()->My() * levels().size() * value_size /
+                  (1024.0 * 1024.0));
 
-    petsc::VecArray tmp_array(tmp);
-    log->message(3, "[%s] Writing %s...\n",
-                 time.c_str(), metadata(j).get_name().c_str());
-    io::write_spatial_variable(metadata(j), *grid(), file, tmp_array.get());
+    log->message(3, "  wrote %.1f MiB in %.3f seconds (%.1f MiB/s)\n", MiB, elapsed,
+                 elapsed > 0.0 ? MiB / elapsed : 0.0);
   }
 }
 
@@ -651,7 +913,10 @@ void  Array::begin_access() const {
 
   if (m_impl->access_counter == 0) {
     PetscErrorCode ierr;
-    if (m_impl->begin_access_use_dof) {
+    if (m_impl->compression != COMPRESSION_NONE) {
+      // values are unpacked one column at a time (see Array3D::get_column())
+      m_impl->release_vec();
+    } else if (m_impl->begin_access_use_dof) {
       ierr = DMDAVecGetArrayDOF(*dm(), vec(), &m_array);
       PISM_CHK(ierr, "DMDAVecGetArrayDOF");
     } else {
@@ -667,9 +932,9 @@ void  Array::begin_access() const {
 void  Array::end_access() const {
   PetscErrorCode ierr;
 
-  if (m_array == NULL) {
+  if (m_impl->access_counter == 0) {
     throw RuntimeError(PISM_ERROR_LOCATION,
-                       "Array::end_access(): a == NULL (looks like begin_access() was not called)");
+                       "Array::end_access(): looks like begin_access() was not called");
   }
 
   if (m_impl->access_counter < 0) {
@@ -678,7 +943,9 @@ void  Array::end_access() const {
 
   m_impl->access_counter--;
   if (m_impl->access_counter == 0) {
-    if (m_impl->begin_access_use_dof) {
+    if (m_impl->compression != COMPRESSION_NONE) {
+      m_impl->flush_columns();
+    } else if (m_impl->begin_access_use_dof) {
       ierr = DMDAVecRestoreArrayDOF(*dm(), vec(), &m_array);
       PISM_CHK(ierr, "DMDAVecRestoreArrayDOF");
     } else {
@@ -733,7 +1000,7 @@ void Array::check_array_indices(int i, int j, unsigned int k) const {
                                   m_impl->name.c_str(), i, j, k);
   }
 
-  if (m_array == NULL) {
+  if (m_impl->access_counter == 0) {
     throw RuntimeError::formatted(PISM_ERROR_LOCATION, "%s: begin_access() was not called", m_impl->name.c_str());
   }
 }
@@ -61,6 +61,9 @@ namespace array {
 //! What "kind" of a vector to create: with or without ghosts.
 enum Kind {WITHOUT_GHOSTS=0, WITH_GHOSTS=1};
 
+//! How values of a 3D array are stored (see Array3D::set_compression()).
+enum Compression {COMPRESSION_NONE=0, COMPRESSION_FLOAT32=1, COMPRESSION_INT16=2};
+
 //! Makes sure that we call begin_access() and end_access() for all accessed array::Arrays.
 class AccessScope {
 public:
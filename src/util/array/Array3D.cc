@@ -16,6 +16,7 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cassert>
@@ -33,6 +34,8 @@
 #include "pism/util/error_handling.hh"
 #include "pism/util/io/IO_Flags.hh"
 #include "pism/util/io/io_helpers.hh"
+#include "pism/util/Logger.hh"
+#include "pism/util/pism_utilities.hh"
 
 namespace pism {
 namespace array {
@@ -45,14 +48,163 @@ Array3D::Array3D(std::shared_ptr<const Grid> grid, const std::string &name, Kind
   set_begin_access_use_dof(true);
 }
 
+//! Use reduced-precision storage if this array is listed in `grid.compressed_3d.variables`.
+/*!
+ * Model components call this for long-lived arrays that are part of the model state;
+ * temporary arrays with the same names (e.g. in diagnostics) are not affected.
+ */
+void Array3D::enable_compression() {
+  auto config = m_impl->grid->ctx()->config();
+
+  auto method = config->get_string("grid.compressed_3d.method");
+  if (method != "none" and
+      member(m_impl->name, set_split(config->get_string("grid.compressed_3d.variables"), ','))) {
+    set_compression(method == "float32" ? COMPRESSION_FLOAT32 : COMPRESSION_INT16);
+  }
+}
+
+//! Store values of this array using reduced precision.
+/*!
+ * A compressed array does not have a double-precision PETSc Vec of its own:
+ *
+ * - get_column() and set_column() unpack and pack one column at a time, keeping a few
+ *   most recently used columns in double precision;
+ * - operations that need the whole array (I/O, ghost updates, arithmetic) use `vec()`,
+ *   which unpacks values into a Vec shared by all compressed arrays with the same layout.
+ *
+ * So the peak memory use is the total size of packed arrays plus one double-precision
+ * Vec per layout (with and without ghosts).
+ *
+ * This method is collective.
+ *
+ * @param[in] method one of COMPRESSION_NONE, COMPRESSION_FLOAT32, COMPRESSION_INT16
+ */
+void Array3D::set_compression(Compression method) {
+  auto &impl = *m_impl;
+
+  if (method == impl.compression) {
+    return;
+  }
+
+  if (impl.access_counter != 0) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "cannot change storage of '%s' while it is accessed",
+                                  impl.name.c_str());
+  }
+
+  PetscErrorCode ierr = 0;
+
+  // current values (in the Vec owned by this array or in the shared one)
+  petsc::Vec &values = vec();
+
+  if (method == COMPRESSION_NONE) {
+    create_vec(*dm(), impl.ghosted, impl.v);
+
+    ierr = VecCopy(values, impl.v);
+    PISM_CHK(ierr, "VecCopy");
+
+    impl.shared_vec->owner = nullptr;
+    impl.shared_vec.reset();
+    impl.free_packed();
+    impl.compression = COMPRESSION_NONE;
+    return;
+  }
+
+  if (impl.compression == COMPRESSION_NONE) {
+    // move values to the shared Vec and free the one owned by this array
+    auto shared = Impl::get_shared_vec(*dm(), impl.ghosted);
+
+    if (shared->owner != nullptr) {
+      shared->owner->release_vec();
+    }
+
+    ierr = VecCopy(values, shared->v);
+    PISM_CHK(ierr, "VecCopy");
+
+    shared->owner   = m_impl;
+    impl.shared_vec = shared;
+
+    ierr = VecDestroy(impl.v.rawptr());
+    PISM_CHK(ierr, "VecDestroy");
+  }
+
+  // allocate packed storage
+  {
+    PetscInt xs = 0, ys = 0, xm = 0, ym = 0;
+    if (impl.ghosted) {
+      ierr = DMDAGetGhostCorners(*dm(), &xs, &ys, nullptr, &xm, &ym, nullptr);
+      PISM_CHK(ierr, "DMDAGetGhostCorners");
+    } else {
+      ierr = DMDAGetCorners(*dm(), &xs, &ys, nullptr, &xm, &ym, nullptr);
+      PISM_CHK(ierr, "DMDAGetCorners");
+    }
+
+    impl.packed_xs = xs;
+    impl.packed_ys = ys;
+    impl.packed_xm = xm;
+    impl.packed_ym = ym;
+
+    const size_t N = impl.column_size(), n_columns = xm * ym;
+
+    impl.free_packed();
+    impl.compression = method;
+
+    if (method == COMPRESSION_FLOAT32) {
+      impl.packed_float.resize(n_columns * N);
+    } else {
+      impl.packed_int16.resize(n_columns * N);
+      impl.column_offset.resize(n_columns);
+      impl.column_scale.resize(n_columns);
+    }
+
+    // enough for a 9-point stencil
+    const int column_cache_size = 9;
+    impl.columns.resize(column_cache_size);
+    for (auto &c : impl.columns) {
+      c.values.resize(N);
+    }
+  }
+
+  // pack current values
+  impl.release_vec();
+
+  // report memory savings
+  {
+    const double MiB = 1024.0 * 1024.0;
+
+    const size_t size = impl.packed_xm * impl.packed_ym * impl.column_size();
+
+    double full   = size * sizeof(double);
+    double packed = (method == COMPRESSION_FLOAT32 ?
+                     size * sizeof(float) :
+                     size * sizeof(uint16_t) + impl.column_offset.size() * 2 * sizeof(double));
+
+    full   = GlobalSum(impl.grid->com, full);
+    packed = GlobalSum(impl.grid->com, packed);
+
+    impl.grid->ctx()->log()->message(
+        2,
+        "* Storing '%s' using %s: %.1f MiB instead of %.1f MiB (all processes).\n"
+        "  Compressed arrays of this size share one %.1f MiB double-precision buffer.\n",
+        impl.name.c_str(),
+        method == COMPRESSION_FLOAT32 ? "single precision" : "scaled 16-bit integers",
+        packed / MiB, full / MiB, full / MiB);
+  }
+}
+
 //! Set all values of scalar quantity to given a single value in a particular column.
 void Array3D::set_column(int i, int j, double c) {
   PetscErrorCode ierr;
 #if (Pism_DEBUG == 1)
-  assert(m_array != NULL);
   check_array_indices(i, j, 0);
 #endif
 
+  if (m_impl->compression != COMPRESSION_NONE) {
+    double *column = m_impl->column(i, j, Impl::COLUMN_OVERWRITE);
+    std::fill(column, column + levels().size(), c);
+    return;
+  }
+
   double ***arr = (double ***)m_array;
 
   if (c == 0.0) {
@@ -70,6 +222,12 @@ void Array3D::set_column(int i, int j, const double *input) {
 #if (Pism_DEBUG == 1)
   check_array_indices(i, j, 0);
 #endif
+  if (m_impl->compression != COMPRESSION_NONE) {
+    double *column = m_impl->column(i, j, Impl::COLUMN_OVERWRITE);
+    std::copy(input, input + m_impl->zlevels.size(), column);
+    return;
+  }
+
   double ***arr       = (double ***)m_array;
   PetscErrorCode ierr = PetscMemcpy(arr[j][i], input, m_impl->zlevels.size() * sizeof(double));
   PISM_CHK(ierr, "PetscMemcpy");
@@ -90,7 +248,6 @@ double Array3D::interpolate(int i, int j, double z) const {
   auto N         = zs.size();
 
 #if (Pism_DEBUG == 1)
-  assert(m_array != NULL);
   check_array_indices(i, j, 0);
 
   if (not legal_level(zs, z)) {
@@ -117,10 +274,21 @@ double Array3D::interpolate(int i, int j, double z) const {
   return valm + incr * (column[mcurr + 1] - valm);
 }
 
+/*!
+ * Returns a pointer to values in the column `(i, j)`.
+ *
+ * For a compressed array (see set_compression()) this is a copy unpacked into double
+ * precision. It stays valid until the end of the outermost access scope or until columns
+ * at 9 other grid points of the same array are requested, whichever comes first.
+ * Modifications are packed when the column is evicted or at the end of the access scope.
+ */
 double *Array3D::get_column(int i, int j) {
 #if (Pism_DEBUG == 1)
   check_array_indices(i, j, 0);
 #endif
+  if (m_impl->compression != COMPRESSION_NONE) {
+    return m_impl->column(i, j, Impl::COLUMN_MODIFY);
+  }
   return ((double ***)m_array)[j][i];
 }
 
@@ -128,6 +296,9 @@ const double *Array3D::get_column(int i, int j) const {
 #if (Pism_DEBUG == 1)
   check_array_indices(i, j, 0);
 #endif
+  if (m_impl->compression != COMPRESSION_NONE) {
+    return m_impl->column(i, j, Impl::COLUMN_READ);
+  }
   return ((double ***)m_array)[j][i];
 }
 
@@ -266,7 +437,7 @@ void Array3D::regrid_impl(const File &file, io::Default default_value) {
 
     io::check_input_grid(input_grid, *grid(), levels());
 
-    LocalInterpCtx lic(input_grid, *grid(), levels(), m_impl->interpolation_type);
+    auto lic = grid()->interpolation_context(input_grid, levels(), m_impl->interpolation_type);
 
     // Note: this call will read the last time record (the index is set in `lic` based on
     // info in `input_grid`).
@@ -54,6 +54,9 @@ public:
   double interpolate(int i, int j, double z) const;
 
   void copy_from(const Array3D &input);
+
+  void set_compression(Compression method);
+  void enable_compression();
 };
 
 void extract_surface(const Array3D &data, double z, Scalar &output);
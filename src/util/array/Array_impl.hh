@@ -19,6 +19,7 @@
 #ifndef PISM_ARRAY_IMPL_HH
 #define PISM_ARRAY_IMPL_HH
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -57,6 +58,13 @@ struct Array::Impl {
     interpolation_type = LINEAR;
 
     bsearch_accel = nullptr;
+
+    compression = COMPRESSION_NONE;
+    packed_xs = 0;
+    packed_ys = 0;
+    packed_xm = 0;
+    packed_ym = 0;
+    column_counter = 0;
   }
   //! If true, report range when regridding.
   bool report_range;
@@ -109,10 +117,61 @@ struct Array::Impl {
 
   // binary search accelerator (used for interpolation in a column in 3D fields)
   gsl_interp_accel *bsearch_accel;
+
+  //! Reduced-precision storage (see Array3D::set_compression()).
+  //!
+  //! Values of a compressed array are unpacked into double precision one column at a time
+  //! by Array3D::get_column() and by `vec()` for operations that need the whole array.
+  Compression compression;
+  std::vector<float> packed_float;
+  std::vector<uint16_t> packed_int16;
+  //! Per-column offsets and scaling factors (COMPRESSION_INT16)
+  std::vector<double> column_offset;
+  std::vector<double> column_scale;
+  //! Corners of the (local or global) sub-domain covered by packed storage
+  int packed_xs, packed_ys, packed_xm, packed_ym;
+
+  //! Double-precision Vec shared by compressed arrays with the same layout.
+  struct SharedVec {
+    petsc::Vec v;
+    //! array that stores its values in `v` (nullptr if none)
+    Impl *owner = nullptr;
+  };
+  std::shared_ptr<SharedVec> shared_vec;
+
+  static std::shared_ptr<SharedVec> get_shared_vec(petsc::DM &dm, bool ghosted);
+
+  //! A column of a compressed array unpacked by Array3D::get_column()
+  struct Column {
+    int i = 0, j = 0;
+    bool valid = false;
+    bool modified = false;
+    uint64_t last_use = 0;
+    std::vector<double> values;
+  };
+  //! Most recently used columns
+  std::vector<Column> columns;
+  uint64_t column_counter;
+
+  enum ColumnAccess { COLUMN_READ, COLUMN_MODIFY, COLUMN_OVERWRITE };
+
+  double *column(int i, int j, ColumnAccess access);
+  void flush_columns();
+  void release_vec();
+
+  size_t column_size() const;
+  size_t column_index(int i, int j) const;
+  void pack(const double *x);
+  void unpack(double *x) const;
+  void pack_column(size_t c, const double *x);
+  void unpack_column(size_t c, double *x) const;
+  void free_packed();
 };
 
 void global_to_local(petsc::DM &dm, Vec source, Vec destination);
 
+void create_vec(petsc::DM &dm, bool ghosted, petsc::Vec &result);
+
 // set default value or stop with an error message (during regridding)
 void set_default_value_or_stop(const std::string &filename, const VariableMetadata &variable,
                                io::Default default_value, const Logger &log,
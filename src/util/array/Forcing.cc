@@ -20,6 +20,7 @@
 #include <cassert>
 #include <cmath>                // std::floor
 #include <array>
+#include <algorithm>            // std::fill
 
 #include "pism/util/array/Forcing.hh"
 #include "pism/util/io/File.hh"
@@ -30,6 +31,7 @@
 
 #include "pism/util/error_handling.hh"
 #include "pism/util/io/io_helpers.hh"
+#include "pism/util/io/RecordCache.hh"
 #include "pism/util/Logger.hh"
 #include "pism/util/interpolation.hh"
 #include "pism/util/Context.hh"
@@ -40,6 +42,65 @@
 namespace pism {
 namespace array {
 
+/*!
+ * Temporal interpolation weights arranged for evaluation at every grid point.
+ *
+ * Consecutive requested times usually fall into the same interval between records (e.g.
+ * daily values interpolated from monthly records), so outputs are grouped into segments
+ * using the same pair of records. Within a segment
+ *
+ *     output[k] = column[L] + alpha[k] * (column[R] - column[L]),
+ *
+ * is a loop over contiguous arrays that the compiler can vectorize. Segments with `L == R`
+ * (piecewise-constant interpolation and constant extrapolation) are filled with a constant.
+ */
+struct InterpolationKernel {
+  struct Segment {
+    int left;
+    int right;
+    unsigned int begin;
+    unsigned int end;
+  };
+
+  std::vector<Segment> segments;
+  std::vector<double> alpha;
+
+  void init(const Interpolation &I) {
+    const auto &L = I.left();
+    const auto &R = I.right();
+
+    alpha = I.alpha();
+    segments.clear();
+
+    unsigned int n = alpha.size();
+    for (unsigned int k = 0; k < n; ++k) {
+      if (segments.empty() or
+          segments.back().left != L[k] or segments.back().right != R[k]) {
+        segments.push_back({L[k], R[k], k, k + 1});
+      } else {
+        segments.back().end = k + 1;
+      }
+    }
+  }
+
+  void evaluate(const double *column, double *output) const {
+    const double *a = alpha.data();
+    for (const auto &s : segments) {
+      const double
+        value = column[s.left],
+        delta = column[s.right] - value;
+
+      if (s.left == s.right) {
+        std::fill(output + s.begin, output + s.end, value);
+      } else {
+        for (unsigned int k = s.begin; k < s.end; ++k) {
+          output[k] = value + a[k] * delta;
+        }
+      }
+    }
+  }
+};
+
 struct Forcing::Data {
   Data()
     : array(nullptr),
@@ -83,6 +144,9 @@ struct Forcing::Data {
   //! temporal interpolation code
   std::shared_ptr<Interpolation> interp;
 
+  //! interpolation weights used by interp(i, j, result)
+  InterpolationKernel kernel;
+
   //! forcing period, in seconds
   double period;
 
@@ -335,7 +399,12 @@ void Forcing::init_periodic_data(const File &file) {
 
   grid::InputGridInfo input_grid(file, V.name, variable.unit_system(), grid()->registration());
 
-  LocalInterpCtx lic(input_grid, *grid(), levels(), m_impl->interpolation_type);
+  auto lic = grid()->interpolation_context(input_grid, levels(), m_impl->interpolation_type);
+
+  io::RecordCache cache(*grid(), ctx->config()->get_string("input.forcing.cache_directory"),
+                        ctx->config()->get_number("input.forcing.cache_max_size") * 1024.0 * 1024.0,
+                        file.filename(), variable.get_name(), variable["units"],
+                        m_impl->interpolation_type);
 
   for (unsigned int j = 0; j < n_records; ++j) {
     {
@@ -343,7 +412,10 @@ void Forcing::init_periodic_data(const File &file) {
       lic.count[T_AXIS] = 1;
 
       petsc::VecArray tmp_array(vec());
-      io::regrid_spatial_variable(variable, *grid(), lic, file, tmp_array.get());
+      if (not cache.read(j, tmp_array.get())) {
+        io::regrid_spatial_variable(variable, *grid(), lic, file, tmp_array.get());
+        cache.write(j, tmp_array.get());
+      }
     }
 
     auto time = ctx->time();
@@ -540,14 +612,23 @@ void Forcing::update(unsigned int start) {
     auto V = file.find_variable(variable.get_name(), variable["standard_name"]);
     grid::InputGridInfo input_grid(file, V.name, variable.unit_system(), grid()->registration());
 
-    LocalInterpCtx lic(input_grid, *grid(), levels(), m_impl->interpolation_type);
+    auto lic = grid()->interpolation_context(input_grid, levels(), m_impl->interpolation_type);
+
+    auto config = m_impl->grid->ctx()->config();
+    io::RecordCache cache(*m_impl->grid, config->get_string("input.forcing.cache_directory"),
+                          config->get_number("input.forcing.cache_max_size") * 1024.0 * 1024.0,
+                          file.filename(), variable.get_name(), variable["units"],
+                          m_impl->interpolation_type);
 
     for (unsigned int j = 0; j < missing; ++j) {
       lic.start[T_AXIS] = (int)(start + j);
       lic.count[T_AXIS] = 1;
 
       petsc::VecArray tmp_array(vec());
-      io::regrid_spatial_variable(variable, *m_impl->grid, lic, file, tmp_array.get());
+      if (not cache.read(start + j, tmp_array.get())) {
+        io::regrid_spatial_variable(variable, *m_impl->grid, lic, file, tmp_array.get());
+        cache.write(start + j, tmp_array.get());
+      }
 
       log->message(5, " %s: reading entry #%02d, year %s...\n", m_impl->name.c_str(), start + j,
                    t->date(m_data->time[start + j]).c_str());
@@ -747,6 +828,18 @@ void Forcing::average(double t, double dt) {
     weights = integration_weights(data, data_size, type, t, t + dt);
   }
 
+  // Convert integration weights into a dense array of averaging weights covering records
+  // [k0, k0 + W.size()) so that the average at a grid point is a dot product with a
+  // contiguous part of the column.
+  size_t k0 = weights.empty() ? 0 : weights.begin()->first;
+  size_t k1 = weights.empty() ? 0 : weights.rbegin()->first + 1;
+  std::vector<double> W(k1 - k0, 0.0);
+  for (const auto &w : weights) {
+    W[w.first - k0] = w.second / dt;
+  }
+  const double *w = W.data();
+  const size_t N = W.size();
+
   array::AccessScope l{this};
   double **a2 = array();
   double ***a3 = array3();
@@ -754,13 +847,13 @@ void Forcing::average(double t, double dt) {
   for (auto p = m_impl->grid->points(); p; p.next()) {
     const int i = p.i(), j = p.j();
 
-    a2[j][i] = 0.0;
-    for (const auto &weight : weights) {
-      size_t k = weight.first;
-      double w = weight.second;
-      a2[j][i] += w * a3[j][i][k];
+    const double *column = a3[j][i] + k0;
+
+    double result = 0.0;
+    for (size_t k = 0; k < N; ++k) {
+      result += w[k] * column[k];
     }
-    a2[j][i] /= dt;
+    a2[j][i] = result;
   }
 }
 
@@ -797,6 +890,8 @@ void Forcing::init_interpolation(const std::vector<double> &ts) {
                                          m_data->n_records,
                                          times_requested.data(),
                                          times_requested.size()));
+
+  m_data->kernel.init(*m_data->interp);
 }
 
 /**
@@ -811,9 +906,9 @@ void Forcing::init_interpolation(const std::vector<double> &ts) {
 void Forcing::interp(int i, int j, std::vector<double> &result) {
   double ***a3 = array3();
 
-  result.resize(m_data->interp->alpha().size());
+  result.resize(m_data->kernel.alpha.size());
 
-  m_data->interp->interpolate(a3[j][i], result.data());
+  m_data->kernel.evaluate(a3[j][i], result.data());
 }
 
 } // end of namespace array
@@ -0,0 +1,212 @@
+// Copyright (C) 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "Measures the cost of temporal interpolation and averaging of 2D forcing fields.\n\n";
+
+#include <cmath>
+#include <mpi.h>
+
+#include "pism/util/Context.hh"
+#include "pism/util/ConfigInterface.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/Logger.hh"
+#include "pism/util/Time.hh"
+#include "pism/util/array/Forcing.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/io/File.hh"
+#include "pism/util/io/io_helpers.hh"
+#include "pism/util/petscwrappers/PetscInitializer.hh"
+#include "pism/util/pism_options.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+
+/*!
+ * Write a forcing file containing `n_records` records of a 2D field covering the modeled time
+ * interval.
+ */
+static void create_forcing(std::shared_ptr<const Grid> grid, const std::string &filename,
+                           int n_records) {
+  auto ctx = grid->ctx();
+  auto time = ctx->time();
+
+  array::Scalar v(grid, "v");
+  v.metadata(0).long_name("forcing field used by the benchmark").units("1");
+
+  std::string time_name = ctx->config()->get_string("time.dimension_name");
+  VariableMetadata bounds(time_name + "_bounds", ctx->unit_system());
+
+  File file(grid->com, filename, io::PISM_NETCDF3, io::PISM_READWRITE_MOVE);
+  io::define_time(file, *ctx);
+  file.write_attribute(time_name, "bounds", bounds.get_name());
+  io::define_time_bounds(bounds, time_name, "nv", file, io::PISM_DOUBLE);
+
+  double
+    t0 = time->start(),
+    dt = (time->end() - t0) / n_records;
+
+  for (int k = 0; k < n_records; ++k) {
+    io::append_time(file, time_name, t0 + (k + 0.5) * dt);
+    io::write_time_bounds(file, bounds, k, { t0 + k * dt, t0 + (k + 1) * dt });
+
+    {
+      array::AccessScope list(v);
+      for (auto p = grid->points(); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        v(i, j) = std::sin(0.01 * i + k) * std::cos(0.02 * j);
+      }
+    }
+    v.write(file);
+  }
+}
+
+/*!
+ * Time `n_repeat` evaluations of the forcing at `n_outputs` times at every grid point (as in
+ * surface and atmosphere models), returning time per evaluation in nanoseconds.
+ */
+static double time_interp(array::Forcing &forcing, int n_outputs, int n_repeat) {
+  auto grid = forcing.grid();
+  auto time = grid->ctx()->time();
+
+  double
+    t0 = time->start(),
+    dt = (time->end() - t0) / n_outputs;
+
+  std::vector<double> ts(n_outputs), values;
+  for (int k = 0; k < n_outputs; ++k) {
+    ts[k] = t0 + k * dt;
+  }
+
+  forcing.init_interpolation(ts);
+
+  double sum = 0.0;
+  double start = get_time(grid->com);
+  {
+    array::AccessScope list(forcing);
+    for (int r = 0; r < n_repeat; ++r) {
+      for (auto p = grid->points(); p; p.next()) {
+        forcing.interp(p.i(), p.j(), values);
+        sum += values[0];
+      }
+    }
+  }
+  double end = get_time(grid->com);
+
+  // use the result to keep the compiler from optimizing the loop away
+  if (std::isnan(sum)) {
+    grid->ctx()->log()->message(1, "NaN in the interpolation result\n");
+  }
+
+  return 1e9 * (end - start) / ((double)n_repeat * grid->xm() * grid->ym() * n_outputs);
+}
+
+/*!
+ * Time `n_repeat` computations of averages over `n_intervals` intervals covering the modeled
+ * time interval, returning time per average per grid point in nanoseconds.
+ */
+static double time_average(array::Forcing &forcing, int n_intervals, int n_repeat) {
+  auto grid = forcing.grid();
+  auto time = grid->ctx()->time();
+
+  double
+    t0 = time->start(),
+    dt = (time->end() - t0) / n_intervals;
+
+  double start = get_time(grid->com);
+  for (int r = 0; r < n_repeat; ++r) {
+    for (int k = 0; k < n_intervals; ++k) {
+      forcing.average(t0 + k * dt, dt);
+    }
+  }
+  double end = get_time(grid->com);
+
+  return 1e9 * (end - start) / ((double)n_repeat * grid->xm() * grid->ym() * n_intervals);
+}
+
+} // end of namespace pism
+
+int main(int argc, char *argv[]) {
+  using namespace pism;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  try {
+    auto ctx = context_from_options(com, "forcing_benchmark");
+    auto log = ctx->log();
+
+    std::string usage =
+      "  forcing_benchmark [-Mx N -My N] [-records N] [-outputs N] [-intervals N] [-repeat N]\n"
+      "where\n"
+      "  -records    number of records in the forcing file\n"
+      "  -outputs    number of times used by interp(i, j, result)\n"
+      "  -intervals  number of intervals used to test average()\n"
+      "  -repeat     number of repetitions\n";
+
+    bool done = show_usage_check_req_opts(*log, "FORCING_BENCHMARK (forcing interpolation benchmark)",
+                                          {}, usage);
+    if (done) {
+      return 0;
+    }
+
+    options::Integer n_records("-records", "number of records in the forcing file", 12);
+    options::Integer n_outputs("-outputs", "number of times used by interp(i, j, result)", 365);
+    options::Integer n_intervals("-intervals", "number of intervals used to test average()", 12);
+    options::Integer n_repeat("-repeat", "number of repetitions", 10);
+
+    auto grid = Grid::FromOptions(ctx);
+
+    std::string filename = "forcing_benchmark_input.nc";
+    create_forcing(grid, filename, n_records);
+
+    struct Mode {
+      std::string name;
+      InterpolationType type;
+      bool periodic;
+    };
+
+    log->message(1, "%d records, %d x %d grid, %d processes\n", n_records.value(),
+                 (int)grid->Mx(), (int)grid->My(), (int)grid->size());
+    log->message(1, "%20s  %22s  %22s\n", "mode", "interp (ns/point/time)",
+                 "average (ns/point)");
+
+    for (const auto &mode : std::vector<Mode>{ { "piecewise-constant", PIECEWISE_CONSTANT, false },
+                                               { "linear", LINEAR, false },
+                                               { "periodic linear", LINEAR, true } }) {
+      File file(com, filename, io::PISM_NETCDF3, io::PISM_READONLY);
+      array::Forcing forcing(grid, file, "v", "", n_records, mode.periodic, mode.type);
+      file.close();
+
+      forcing.metadata().long_name("forcing field used by the benchmark").units("1");
+      forcing.init(filename, mode.periodic);
+      forcing.update(ctx->time()->start(), ctx->time()->end() - ctx->time()->start());
+
+      double interp  = time_interp(forcing, n_outputs, n_repeat);
+      double average = time_average(forcing, n_intervals, n_repeat);
+
+      log->message(1, "%20s  %22.3f  %22.3f\n", mode.name.c_str(), interp, average);
+    }
+  } catch (...) {
+    handle_fatal_errors(com);
+    return 1;
+  }
+
+  return 0;
+}
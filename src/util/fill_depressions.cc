@@ -0,0 +1,174 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>            // std::max, std::min
+#include <cmath>                // std::isinf
+#include <functional>           // std::greater
+#include <limits>
+#include <queue>
+#include <utility>              // std::pair
+#include <vector>
+
+#include "pism/util/fill_depressions.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/array/Scalar.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+
+int fill_depressions(const array::Scalar &mask, double epsilon, array::Scalar1 &surface) {
+  auto grid = surface.grid();
+
+  const int
+    xs = grid->xs(),
+    ys = grid->ys(),
+    xm = grid->xm(),
+    ym = grid->ym(),
+    Mx = (int)grid->Mx(),
+    My = (int)grid->My();
+
+  const double infinity = std::numeric_limits<double>::infinity();
+
+  // original surface elevation and the "outlet" flag at owned grid points
+  std::vector<double> Z(xm * ym);
+  std::vector<bool> outlet(xm * ym);
+  {
+    array::AccessScope list{ &mask, &surface };
+
+    for (auto p = grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j(), k = (j - ys) * xm + (i - xs);
+
+      Z[k]      = surface(i, j);
+      outlet[k] = mask(i, j) < 0.5 or i == 0 or j == 0 or i == Mx - 1 or j == My - 1;
+
+      surface(i, j) = outlet[k] ? Z[k] : infinity;
+    }
+  }
+  surface.update_ghosts();
+
+  // offsets of the 4 neighbors of a grid point
+  const int di[] = { 1, -1, 0, 0 };
+  const int dj[] = { 0, 0, 1, -1 };
+
+  typedef std::pair<double, int> Cell;
+  std::priority_queue<Cell, std::vector<Cell>, std::greater<Cell> > queue;
+
+  std::vector<double> W(xm * ym);
+  std::vector<bool> done(xm * ym);
+
+  int n_sweeps = 0;
+  while (true) {
+    n_sweeps += 1;
+
+    array::AccessScope list{ &surface };
+
+    // Initialize: outlets are fixed, other points get the lowest value allowed by their
+    // neighbors in other sub-domains (ghosts).
+    for (int j = ys; j < ys + ym; ++j) {
+      for (int i = xs; i < xs + xm; ++i) {
+        const int k = (j - ys) * xm + (i - xs);
+
+        done[k] = false;
+
+        if (outlet[k]) {
+          W[k] = Z[k];
+        } else {
+          W[k] = infinity;
+          for (int n = 0; n < 4; ++n) {
+            int I = i + di[n], J = j + dj[n];
+            bool ghost = I < xs or I >= xs + xm or J < ys or J >= ys + ym;
+            if (ghost) {
+              W[k] = std::min(W[k], std::max(Z[k], surface(I, J) + epsilon));
+            }
+          }
+        }
+
+        if (W[k] < infinity) {
+          queue.emplace(W[k], k);
+        }
+      }
+    }
+
+    // priority-flood
+    while (not queue.empty()) {
+      auto cell = queue.top();
+      queue.pop();
+
+      const int k = cell.second;
+      if (done[k]) {
+        continue;
+      }
+      done[k] = true;
+
+      const int i = xs + k % xm, j = ys + k / xm;
+
+      for (int n = 0; n < 4; ++n) {
+        int I = i + di[n], J = j + dj[n];
+
+        if (I < xs or I >= xs + xm or J < ys or J >= ys + ym) {
+          continue;
+        }
+
+        const int K = (J - ys) * xm + (I - xs);
+        if (done[K] or outlet[K]) {
+          continue;
+        }
+
+        double value = std::max(Z[K], W[k] + epsilon);
+        if (value < W[K]) {
+          W[K] = value;
+          queue.emplace(value, K);
+        }
+      }
+    }
+
+    int n_changed = 0;
+    for (auto p = grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j(), k = (j - ys) * xm + (i - xs);
+
+      if (W[k] != surface(i, j)) {
+        surface(i, j) = W[k];
+        n_changed += 1;
+      }
+    }
+    surface.update_ghosts();
+
+    if (GlobalSum(grid->com, n_changed) == 0) {
+      break;
+    }
+  }
+
+  // points that are not connected to an outlet keep their values
+  {
+    array::AccessScope list{ &surface };
+
+    for (auto p = grid->points(); p; p.next()) {
+      const int i = p.i(), j = p.j(), k = (j - ys) * xm + (i - xs);
+
+      if (std::isinf(surface(i, j))) {
+        surface(i, j) = Z[k];
+      }
+    }
+  }
+  surface.update_ghosts();
+
+  return n_sweeps;
+}
+
+} // end of namespace pism
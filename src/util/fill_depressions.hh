@@ -0,0 +1,54 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_FILL_DEPRESSIONS_H
+#define PISM_FILL_DEPRESSIONS_H
+
+namespace pism {
+
+namespace array {
+class Scalar;
+class Scalar1;
+}
+
+/*!
+ * Fill depressions in `surface` so that water can flow from every cell to an outlet.
+ *
+ * Outlets are cells where `mask` is zero and cells at the edge of the computational
+ * domain. Values at outlets are not modified. Elsewhere the result is the lowest surface
+ * that is not below the input and has a path to an outlet along which it decreases by at
+ * least `epsilon` between adjacent cells (using 4-connectivity). Cells that are not
+ * connected to an outlet keep their values.
+ *
+ * Uses priority-flood (a variant of Dijkstra's algorithm) on each sub-domain, treating
+ * ghost values as boundary conditions, and exchanges ghosts until no value changes. This
+ * requires one sweep plus one sweep per sub-domain boundary crossed by the longest
+ * "spill path". The result does not depend on the domain decomposition.
+ *
+ * @param[in] mask ones in the domain, zeros at outlets
+ * @param[in] epsilon minimum decrease between adjacent cells along a flow path
+ * @param[in,out] surface surface to fill (ghosts are updated)
+ *
+ * @return the number of sweeps
+ */
+int fill_depressions(const array::Scalar &mask, double epsilon, array::Scalar1 &surface);
+
+} // end of namespace pism
+
+#endif /* PISM_FILL_DEPRESSIONS_H */
@@ -0,0 +1,176 @@
+// Copyright (C) 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "Measures the cost of filling depressions in a synthetic digital elevation model.\n\n";
+
+#include <cmath>
+#include <cstdint>
+#include <mpi.h>
+
+#include "pism/util/Context.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/Logger.hh"
+#include "pism/util/array/Scalar.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/fill_depressions.hh"
+#include "pism/util/petscwrappers/PetscInitializer.hh"
+#include "pism/util/pism_options.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+
+/*!
+ * Pseudo-random number in [-1, 1] depending on `i` and `j` only (so that the surface does
+ * not depend on the domain decomposition).
+ */
+static double noise(int i, int j) {
+  uint32_t h = (uint32_t)i * 374761393u + (uint32_t)j * 668265263u;
+  h = (h ^ (h >> 13)) * 1274126177u;
+  h = h ^ (h >> 16);
+  return 2.0 * (h / 4294967295.0) - 1.0;
+}
+
+/*!
+ * Create a "rough" surface with many depressions of all sizes: a sum of waves with
+ * decreasing wave lengths and amplitudes plus noise. Cells below zero are outlets ("ocean").
+ */
+static void create_surface(array::Scalar &mask, array::Scalar &surface) {
+  auto grid = surface.grid();
+
+  const int
+    Mx = (int)grid->Mx(),
+    My = (int)grid->My();
+
+  const int n_waves = 6;
+
+  array::AccessScope list{ &mask, &surface };
+
+  for (auto p = grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    double
+      x = (double)i / Mx,
+      y = (double)j / My,
+      z = 0.0;
+
+    for (int k = 0; k < n_waves; ++k) {
+      double
+        f = 2.0 * M_PI * (1 << k),
+        phase = 0.7 * k;
+      z += 1000.0 / (1 << k) * std::sin(f * x + phase) * std::cos(f * y - 2.0 * phase);
+    }
+    z += 20.0 * noise(i, j);
+
+    surface(i, j) = z;
+    mask(i, j)    = z > 0.0 ? 1.0 : 0.0;
+  }
+}
+
+/*!
+ * Count cells in the domain that are not higher than any of their neighbors (sinks).
+ */
+static int count_sinks(const array::Scalar &mask, const array::Scalar1 &surface) {
+  auto grid = surface.grid();
+
+  const int
+    Mx = (int)grid->Mx(),
+    My = (int)grid->My();
+
+  array::AccessScope list{ &mask, &surface };
+
+  int result = 0;
+  for (auto p = grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    if (mask(i, j) < 0.5 or i == 0 or j == 0 or i == Mx - 1 or j == My - 1) {
+      continue;
+    }
+
+    auto z = surface.star(i, j);
+    if (z.c <= z.e and z.c <= z.w and z.c <= z.n and z.c <= z.s) {
+      result += 1;
+    }
+  }
+
+  return GlobalSum(grid->com, result);
+}
+
+} // end of namespace pism
+
+int main(int argc, char *argv[]) {
+  using namespace pism;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  try {
+    auto ctx = context_from_options(com, "fill_depressions_benchmark");
+    auto log = ctx->log();
+
+    std::string usage =
+      "  fill_depressions_benchmark [-Mx N -My N] [-epsilon X] [-repeat N]\n"
+      "where\n"
+      "  -epsilon  minimum decrease of the surface elevation along a flow path, in meters\n"
+      "  -repeat   number of repetitions\n";
+
+    bool done = show_usage_check_req_opts(*log, "FILL_DEPRESSIONS_BENCHMARK (depression filling benchmark)",
+                                          {}, usage);
+    if (done) {
+      return 0;
+    }
+
+    options::Real epsilon(ctx->unit_system(), "-epsilon",
+                          "minimum decrease of the surface elevation along a flow path", "m",
+                          0.01);
+    options::Integer n_repeat("-repeat", "number of repetitions", 10);
+
+    auto grid = Grid::FromOptions(ctx);
+
+    array::Scalar mask(grid, "mask");
+    array::Scalar dem(grid, "dem");
+    array::Scalar1 surface(grid, "surface");
+
+    create_surface(mask, dem);
+
+    surface.copy_from(dem);
+    int n_sinks = count_sinks(mask, surface);
+
+    int n_sweeps = 0;
+    double elapsed = 0.0;
+    for (int r = 0; r < n_repeat; ++r) {
+      surface.copy_from(dem);
+
+      double start = get_time(com);
+      n_sweeps = fill_depressions(mask, epsilon, surface);
+      elapsed += get_time(com) - start;
+    }
+
+    log->message(1, "%d x %d grid, %d processes\n", (int)grid->Mx(), (int)grid->My(),
+                 (int)grid->size());
+    log->message(1, "sinks before: %d, after: %d\n", n_sinks, count_sinks(mask, surface));
+    log->message(1, "%d sweeps, %.3f s per call, %.3f ns per point\n", n_sweeps,
+                 elapsed / n_repeat,
+                 1e9 * elapsed / ((double)n_repeat * grid->Mx() * grid->My()));
+  } catch (...) {
+    handle_fatal_errors(com);
+    return 1;
+  }
+
+  return 0;
+}
@@ -52,6 +52,17 @@ struct File::Impl {
   MPI_Comm com;
   io::Backend backend;
   io::NCFile::Ptr nc;
+
+  //! Coordinate variables and dimension types read from this file. Regridding reads the
+  //! same coordinate variables for every variable defined on a given grid.
+  std::map<std::string, std::vector<double> > dimension_cache;
+  std::map<std::string, AxisType> dimension_type_cache;
+
+  //! Clear cached metadata (called whenever the file may be modified).
+  void clear_cache() {
+    dimension_cache.clear();
+    dimension_type_cache.clear();
+  }
 };
 
 io::Backend string_to_backend(const std::string &backend) {
@@ -223,6 +234,16 @@ void File::set_compression_level(int level) const {
   m_impl->nc->set_compression_level(level);
 }
 
+/*!
+ * Set the number of significant digits to keep in 2D and 3D floating point variables
+ * defined after this call (0 disables quantization).
+ *
+ * Only NetCDF-4 backends support this; others ignore it.
+ */
+void File::set_quantization(int digits) const {
+  m_impl->nc->set_quantization(digits);
+}
+
 void File::open(const std::string &filename, io::Mode mode) {
   try {
 
@@ -259,6 +280,8 @@ void File::open(const std::string &filename, io::Mode mode) {
 }
 
 void File::remove_attribute(const std::string &variable_name, const std::string &att_name) const {
+  m_impl->clear_cache();
+
   try {
     m_impl->nc->del_att(variable_name, att_name);
   } catch (RuntimeError &e) {
@@ -268,6 +291,8 @@ void File::remove_attribute(const std::string &variable_name, const std::string
 }
 
 void File::close() {
+  m_impl->clear_cache();
+
   try {
     m_impl->nc->close();
   } catch (RuntimeError &e) {
@@ -286,6 +311,8 @@ void File::sync() const {
 }
 
 void File::redef() const {
+  m_impl->clear_cache();
+
   try {
     m_impl->nc->redef();
   } catch (RuntimeError &e) {
@@ -434,6 +461,18 @@ std::vector<std::string> File::dimensions(const std::string &variable_name) cons
   }
 }
 
+io::Type File::variable_type(const std::string &variable_name) const {
+  try {
+    io::Type result = io::PISM_NAT;
+    m_impl->nc->inq_vartype(variable_name, result);
+    return result;
+  } catch (RuntimeError &e) {
+    e.add_context("getting the type of variable '%s' in '%s'", variable_name.c_str(),
+                  filename().c_str());
+    throw;
+  }
+}
+
 
 //! \brief Checks if a dimension exists.
 bool File::find_dimension(const std::string &name) const {
@@ -492,6 +531,20 @@ AxisType axis_type_from_string(const std::string &input) {
  */
 AxisType File::dimension_type(const std::string &name,
                               units::System::Ptr unit_system) const {
+  auto cached = m_impl->dimension_type_cache.find(name);
+  if (cached != m_impl->dimension_type_cache.end()) {
+    return cached->second;
+  }
+
+  auto result = dimension_type_impl(name, unit_system);
+
+  m_impl->dimension_type_cache[name] = result;
+
+  return result;
+}
+
+AxisType File::dimension_type_impl(const std::string &name,
+                                   units::System::Ptr unit_system) const {
   try {
     if (not find_variable(name)) {
       throw RuntimeError(PISM_ERROR_LOCATION, "coordinate variable " + name + " is missing");
@@ -561,6 +614,8 @@ AxisType File::dimension_type(const std::string &name,
 }
 
 void File::define_dimension(const std::string &name, size_t length) const {
+  m_impl->clear_cache();
+
   try {
     m_impl->nc->def_dim(name, length);
   } catch (RuntimeError &e) {
@@ -571,37 +626,40 @@ void File::define_dimension(const std::string &name, size_t length) const {
 
 //! \brief Define a variable.
 void File::define_variable(const std::string &name, io::Type nctype, const std::vector<std::string> &dims) const {
+  m_impl->clear_cache();
+
   try {
     m_impl->nc->def_var(name, nctype, dims);
-
-    // FIXME: I need to write and tune chunk_dimensions that would be called below before we use
-    // this.
-    //
-    /*
-    // if it's not a spatial variable, we're done
-    if (dims.size() < 2) {
-      return;
-    }
-
-    std::vector<size_t> dim_lengths;
-    for (unsigned int k = 0; k < dims.size(); ++k) {
-      dim_lengths.push_back(this->dimension_length(dims[k]));
-    }
-
-    std::vector<size_t> chunk_dims = chunk_dimensions(nctype, dim_lengths);
-
-    m_impl->nc->def_var_chunking(name, chunk_dims);
-    */
-
   } catch (RuntimeError &e) {
     e.add_context("defining variable '%s' in '%s'", name.c_str(), filename().c_str());
     throw;
   }
 }
 
+/*!
+ * Set chunk sizes of a variable (one per dimension).
+ *
+ * Has to be called right after define_variable(). Backends that don't support chunking
+ * ignore it.
+ */
+void File::define_chunking(const std::string &name, const std::vector<size_t> &chunk_dims) const {
+  try {
+    std::vector<size_t> tmp = chunk_dims;
+    m_impl->nc->def_var_chunking(name, tmp);
+  } catch (RuntimeError &e) {
+    e.add_context("setting chunk sizes of '%s' in '%s'", name.c_str(), filename().c_str());
+    throw;
+  }
+}
+
 //! \brief Get dimension data (a coordinate variable).
 std::vector<double>  File::read_dimension(const std::string &name) const {
   try {
+    auto cached = m_impl->dimension_cache.find(name);
+    if (cached != m_impl->dimension_cache.end()) {
+      return cached->second;
+    }
+
     if (not find_variable(name)) {
       throw RuntimeError(PISM_ERROR_LOCATION, "coordinate variable not found");
     }
@@ -612,6 +670,8 @@ std::vector<double>  File::read_dimension(const std::string &name) const {
 
     read_variable(name, {0}, {length}, result.data());
 
+    m_impl->dimension_cache[name] = result;
+
     return result;
   } catch (RuntimeError &e) {
     e.add_context("reading dimension '%s' from '%s'", name.c_str(), filename().c_str());
@@ -637,6 +697,8 @@ void File::append_history(const std::string &history) const {
 //! \brief Write a multiple-valued double attribute.
 void File::write_attribute(const std::string &var_name, const std::string &att_name, io::Type nctype,
                            const std::vector<double> &values) const {
+  m_impl->clear_cache();
+
   try {
     redef();
     m_impl->nc->put_att_double(var_name, att_name, nctype, values);
@@ -650,6 +712,8 @@ void File::write_attribute(const std::string &var_name, const std::string &att_n
 //! \brief Write a text attribute.
 void File::write_attribute(const std::string &var_name, const std::string &att_name,
                            const std::string &value) const {
+  m_impl->clear_cache();
+
   try {
     redef();
     // ensure that the string is null-terminated
@@ -761,6 +825,8 @@ void File::write_variable(const std::string &variable_name,
                           const std::vector<unsigned int> &start,
                           const std::vector<unsigned int> &count,
                           const double *op) const {
+  m_impl->clear_cache();
+
   try {
     m_impl->nc->put_vara_double(variable_name, start, count, op);
   } catch (RuntimeError &e) {
@@ -775,6 +841,8 @@ void File::write_distributed_array(const std::string &variable_name,
                                    unsigned int z_count,
                                    bool time_dependent,
                                    const double *input) const {
+  m_impl->clear_cache();
+
   try {
     unsigned int t_length = nrecords();
     assert(t_length > 0);
@@ -104,10 +104,14 @@ public:
   void define_variable(const std::string &name, io::Type nctype,
                        const std::vector<std::string> &dims) const;
 
+  void define_chunking(const std::string &name, const std::vector<size_t> &chunk_dims) const;
+
   VariableLookupData find_variable(const std::string &short_name, const std::string &std_name) const;
 
   bool find_variable(const std::string &short_name) const;
 
+  io::Type variable_type(const std::string &variable_name) const;
+
   void read_variable(const std::string &variable_name,
                        const std::vector<unsigned int> &start,
                        const std::vector<unsigned int> &count,
@@ -131,6 +135,8 @@ public:
 
   void set_compression_level(int level) const;
 
+  void set_quantization(int digits) const;
+
   // attributes
 
   void remove_attribute(const std::string &variable_name, const std::string &att_name) const;
@@ -157,6 +163,8 @@ private:
 
   void open(const std::string &filename, io::Mode mode);
 
+  AxisType dimension_type_impl(const std::string &name, units::System::Ptr unit_system) const;
+
   // disable copying and assignments
   File(const File &other);
   File & operator=(const File &);
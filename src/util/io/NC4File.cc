@@ -25,9 +25,12 @@
 #endif
 #include <netcdf.h>
 
+#include <algorithm>             // std::max
+
 #include "pism/util/io/pism_type_conversion.hh"
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/io/netcdf_helpers.hh"
 
 namespace pism {
 namespace io {
@@ -40,7 +43,7 @@ static void check(const ErrorLocation &where, int return_code) {
 }
 
 NC4File::NC4File(MPI_Comm c, unsigned int compression_level)
-  : NCFile(c), m_compression_level(compression_level) {
+  : NCFile(c), m_compression_level(compression_level), m_quantization_digits(0) {
   // empty
 }
 
@@ -142,6 +145,17 @@ void NC4File::def_var_impl(const std::string &name,
 
     check(PISM_ERROR_LOCATION, stat);
   }
+
+  // Quantize 2D and 3D floating point variables
+  if (m_quantization_digits > 0 and dims.size() > 1 and
+      (nctype == PISM_FLOAT or nctype == PISM_DOUBLE)) {
+    stat = define_quantization(m_file_id, varid, nctype, m_quantization_digits);
+    check(PISM_ERROR_LOCATION, stat);
+  }
+}
+
+void NC4File::set_quantization_impl(int digits) const {
+  m_quantization_digits = std::max(digits, 0);
 }
 
 void NC4File::def_var_chunking_impl(const std::string &name,
@@ -236,6 +250,14 @@ void NC4File::inq_varnatts_impl(const std::string &variable_name, int &result) c
   check(PISM_ERROR_LOCATION, stat);
 }
 
+void NC4File::inq_vartype_impl(const std::string &variable_name, io::Type &result) const {
+  nc_type tmp = NC_NAT;
+  int stat = nc_inq_vartype(m_file_id, get_varid(variable_name), &tmp);
+  check(PISM_ERROR_LOCATION, stat);
+
+  result = nc_type_to_pism_type(tmp);
+}
+
 void NC4File::inq_varid_impl(const std::string &variable_name, bool &exists) const {
   int varid = -1;
 
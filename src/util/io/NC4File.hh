@@ -59,6 +59,8 @@ protected:
   virtual void def_var_impl(const std::string &name,
                            io::Type nctype, const std::vector<std::string> &dims) const;
 
+  virtual void set_quantization_impl(int digits) const;
+
   virtual void get_vara_double_impl(const std::string &variable_name,
                                    const std::vector<unsigned int> &start,
                                    const std::vector<unsigned int> &count,
@@ -80,6 +82,8 @@ protected:
 
   virtual void inq_varnatts_impl(const std::string &variable_name, int &result) const;
 
+  virtual void inq_vartype_impl(const std::string &variable_name, io::Type &result) const;
+
   virtual void inq_varid_impl(const std::string &variable_name, bool &exists) const;
 
   virtual void inq_varname_impl(unsigned int j, std::string &result) const;
@@ -112,6 +116,8 @@ protected:
 
   mutable unsigned int m_compression_level;
 
+  mutable int m_quantization_digits;
+
   int get_varid(const std::string &variable_name) const;
 };
 
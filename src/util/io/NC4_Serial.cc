@@ -25,7 +25,10 @@
 #endif
 #include <netcdf.h>
 
+#include <algorithm>             // std::max
+
 #include "pism/util/error_handling.hh"
+#include "pism/util/io/netcdf_helpers.hh"
 #include "pism/util/pism_utilities.hh"
 
 namespace pism {
@@ -39,7 +42,7 @@ static void check(const ErrorLocation &where, int return_code) {
 }
 
 NC4_Serial::NC4_Serial(MPI_Comm c)
-  : NC_Serial(c), m_compression_level(0) {
+  : NC_Serial(c), m_compression_level(0), m_quantization_digits(0) {
   // empty
 }
 
@@ -61,6 +64,10 @@ void NC4_Serial::set_compression_level_impl(int level) const {
   m_compression_level = pism::clip(level, 0, 9);
 }
 
+void NC4_Serial::set_quantization_impl(int digits) const {
+  m_quantization_digits = std::max(digits, 0);
+}
+
 void NC4_Serial::def_var_impl(const std::string &name,
                               io::Type nctype,
                               const std::vector<std::string> &dims) const {
@@ -84,6 +91,28 @@ void NC4_Serial::def_var_impl(const std::string &name,
     }
   }
 
+  // quantize 2D and 3D floating point variables
+  if (stat == NC_NOERR and m_quantization_digits > 0 and dims.size() > 1 and
+      (nctype == PISM_FLOAT or nctype == PISM_DOUBLE)) {
+    if (m_rank == 0) {
+      stat = define_quantization(m_file_id, get_varid(name), nctype, m_quantization_digits);
+    }
+  }
+
+  MPI_Barrier(m_com);
+  MPI_Bcast(&stat, 1, MPI_INT, 0, m_com);
+
+  check(PISM_ERROR_LOCATION, stat);
+}
+
+void NC4_Serial::def_var_chunking_impl(const std::string &name,
+                                       std::vector<size_t> &dimensions) const {
+  int stat = NC_NOERR;
+
+  if (m_rank == 0) {
+    stat = nc_def_var_chunking(m_file_id, get_varid(name), NC_CHUNKED, dimensions.data());
+  }
+
   MPI_Barrier(m_com);
   MPI_Bcast(&stat, 1, MPI_INT, 0, m_com);
 
@@ -33,12 +33,17 @@ public:
 protected:
   void set_compression_level_impl(int level) const;
 
+  void set_quantization_impl(int digits) const;
+
+  void def_var_chunking_impl(const std::string &name, std::vector<size_t> &dimensions) const;
+
   void create_impl(const std::string &filename);
 
   void def_var_impl(const std::string &name, io::Type nctype,
                     const std::vector<std::string> &dims) const;
 
   mutable int m_compression_level;
+  mutable int m_quantization_digits;
 };
 
 } // end of namespace io
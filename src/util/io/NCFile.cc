@@ -49,6 +49,15 @@ void NCFile::set_compression_level_impl(int level) const {
   // the default implementation does nothing
 }
 
+void NCFile::set_quantization(int digits) const {
+  set_quantization_impl(digits);
+}
+
+void NCFile::set_quantization_impl(int digits) const {
+  (void) digits;
+  // the default implementation does nothing
+}
+
 void NCFile::def_var_chunking_impl(const std::string &name,
                                    std::vector<size_t> &dimensions) const {
   (void) name;
@@ -217,6 +226,10 @@ void NCFile::inq_varnatts(const std::string &variable_name, int &result) const {
   this->inq_varnatts_impl(variable_name, result);
 }
 
+void NCFile::inq_vartype(const std::string &variable_name, io::Type &result) const {
+  this->inq_vartype_impl(variable_name, result);
+}
+
 void NCFile::inq_varid(const std::string &variable_name, bool &result) const {
   this->inq_varid_impl(variable_name, result);
 }
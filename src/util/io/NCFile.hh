@@ -111,12 +111,16 @@ public:
 
   void inq_varnatts(const std::string &variable_name, int &result) const;
 
+  void inq_vartype(const std::string &variable_name, io::Type &result) const;
+
   void inq_varid(const std::string &variable_name, bool &result) const;
 
   void inq_varname(unsigned int j, std::string &result) const;
 
   void set_compression_level(int level) const;
 
+  void set_quantization(int digits) const;
+
   // att
   void get_att_double(const std::string &variable_name, const std::string &att_name,
                       std::vector<double> &result) const;
@@ -197,12 +201,16 @@ protected:
 
   virtual void inq_varnatts_impl(const std::string &variable_name, int &result) const = 0;
 
+  virtual void inq_vartype_impl(const std::string &variable_name, io::Type &result) const = 0;
+
   virtual void inq_varid_impl(const std::string &variable_name, bool &exists) const = 0;
 
   virtual void inq_varname_impl(unsigned int j, std::string &result) const = 0;
 
   virtual void set_compression_level_impl(int level) const = 0;
 
+  virtual void set_quantization_impl(int digits) const;
+
   // att
   virtual void get_att_double_impl(const std::string &variable_name, const std::string &att_name,
                                    std::vector<double> &result) const = 0;
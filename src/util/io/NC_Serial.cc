@@ -324,11 +324,12 @@ void NC_Serial::get_var_double(const std::string &variable_name,
 
   // now we need to send start, count and imap data to processor 0 and receive data
   if (m_rank == 0) {
+    // Data owned by processor 0 is read directly into `ip`; this buffer is used to
+    // receive data from other processors only.
     std::vector<double> processor_0_buffer;
-    // Note: this could be optimized: if processor_0_chunk_size <=
-    // max(local_chunk_size) we can avoid allocating this buffer. The inner for
-    // loop will have to be re-ordered, though.
-    processor_0_buffer.resize(processor_0_chunk_size);
+    if (com_size > 1) {
+      processor_0_buffer.resize(processor_0_chunk_size);
+    }
 
     // MPI calls below require C datatypes (so that we don't have to worry
     // about sizes of size_t and ptrdiff_t), so we make local copies of start,
@@ -362,21 +363,18 @@ void NC_Serial::get_var_double(const std::string &variable_name,
                           // stride == NULL case.
       }
 
+      double *buffer = (r == 0) ? ip : processor_0_buffer.data();
+
       if (transposed) {
         stat = nc_get_varm_double(m_file_id, varid, nc_start.data(), nc_count.data(),
-                                  nc_stride.data(), nc_imap.data(), processor_0_buffer.data());
+                                  nc_stride.data(), nc_imap.data(), buffer);
       } else {
-        stat = nc_get_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(),
-                                  processor_0_buffer.data());
+        stat = nc_get_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(), buffer);
       }
       check(PISM_ERROR_LOCATION, stat);
 
       if (r != 0) {
-        MPI_Send(processor_0_buffer.data(), (int)local_chunk_size, MPI_DOUBLE, r, data_tag, m_com);
-      } else {
-        for (unsigned int k = 0; k < local_chunk_size; ++k) {
-          ip[k] = processor_0_buffer[k];
-        }
+        MPI_Send(buffer, (int)local_chunk_size, MPI_DOUBLE, r, data_tag, m_com);
       }
     } // end of the for loop
 
@@ -416,8 +414,12 @@ void NC_Serial::put_vara_double_impl(const std::string &variable_name,
 
   // now we need to send start and count data to processor 0 and receive data
   if (m_rank == 0) {
+    // Data owned by processor 0 is written directly from `op`; this buffer is used to
+    // receive data from other processors only.
     std::vector<double> processor_0_buffer;
-    processor_0_buffer.resize(processor_0_chunk_size);
+    if (com_size > 1) {
+      processor_0_buffer.resize(processor_0_chunk_size);
+    }
 
     // MPI calls below require C datatypes (so that we don't have to worry about sizes of
     // size_t and ptrdiff_t), so we make local copies of start and count to use in the
@@ -430,6 +432,7 @@ void NC_Serial::put_vara_double_impl(const std::string &variable_name,
     check_and_abort(m_com, PISM_ERROR_LOCATION, stat);
 
     for (int r = 0; r < com_size; ++r) {
+      const double *buffer = op;
 
       if (r != 0) {
         // Note: start, count, and local_chunk_size on processor zero are used *before*
@@ -440,10 +443,7 @@ void NC_Serial::put_vara_double_impl(const std::string &variable_name,
 
         MPI_Recv(processor_0_buffer.data(), local_chunk_size, MPI_DOUBLE, r, data_tag, m_com,
                  &mpi_stat);
-      } else {
-        for (unsigned int k = 0; k < local_chunk_size; ++k) {
-          processor_0_buffer[k] = op[k];
-        }
+        buffer = processor_0_buffer.data();
       }
 
       // This for loop uses start and count passed in as arguments when r == 0. For r > 0
@@ -456,8 +456,7 @@ void NC_Serial::put_vara_double_impl(const std::string &variable_name,
                           // stride == NULL case.
       }
 
-      stat = nc_put_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(),
-                                processor_0_buffer.data());
+      stat = nc_put_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(), buffer);
       check(PISM_ERROR_LOCATION, stat);
     } // end of the for loop
   } else {
@@ -561,6 +560,31 @@ void NC_Serial::inq_varnatts_impl(const std::string &variable_name, int &result)
   MPI_Bcast(&result, 1, MPI_INT, 0, m_com);
 }
 
+//! \brief Gets the type of a variable.
+void NC_Serial::inq_vartype_impl(const std::string &variable_name, io::Type &result) const {
+  int stat = NC_NOERR, tmp = NC_NAT;
+
+  if (m_rank == 0) {
+    int varid = get_varid(variable_name);
+
+    if (varid >= NC_GLOBAL) {
+      nc_type nctype = NC_NAT;
+      stat = nc_inq_vartype(m_file_id, varid, &nctype);
+      tmp  = static_cast<int>(nctype);
+    } else {
+      stat = varid; // LCOV_EXCL_LINE
+    }
+  }
+  MPI_Barrier(m_com);
+
+  MPI_Bcast(&stat, 1, MPI_INT, 0, m_com);
+  check(PISM_ERROR_LOCATION, stat);
+
+  MPI_Bcast(&tmp, 1, MPI_INT, 0, m_com);
+
+  result = nc_type_to_pism_type(tmp);
+}
+
 //! \brief Finds a variable and sets the "exists" flag.
 void NC_Serial::inq_varid_impl(const std::string &variable_name, bool &exists) const {
   int stat, flag = -1;
@@ -263,6 +263,15 @@ void PNCFile::inq_varnatts_impl(const std::string &variable_name, int &result) c
 }
 
 
+void PNCFile::inq_vartype_impl(const std::string &variable_name, io::Type &result) const {
+  nc_type tmp = NC_NAT;
+  int stat    = ncmpi_inq_vartype(m_file_id, get_varid(variable_name), &tmp);
+  check(PISM_ERROR_LOCATION, stat);
+
+  result = nc_type_to_pism_type(tmp);
+}
+
+
 void PNCFile::inq_varid_impl(const std::string &variable_name, bool &exists) const {
   int stat, flag = -1;
 
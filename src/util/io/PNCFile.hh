@@ -84,6 +84,8 @@ protected:
 
   void inq_varnatts_impl(const std::string &variable_name, int &result) const;
 
+  void inq_vartype_impl(const std::string &variable_name, io::Type &result) const;
+
   void inq_varid_impl(const std::string &variable_name, bool &exists) const;
 
   void inq_varname_impl(unsigned int j, std::string &result) const;
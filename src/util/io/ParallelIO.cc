@@ -193,9 +193,20 @@ void ParallelIO::def_var_impl(const std::string &name, io::Type nctype,
 
 void ParallelIO::def_var_chunking_impl(const std::string &name,
                                        std::vector<size_t> &dimensions) const {
-  (void)name;
-  (void)dimensions;
-  // FIXME
+  // only HDF5-based files support chunking
+  if (not (m_iotype == PIO_IOTYPE_NETCDF4P or m_iotype == PIO_IOTYPE_NETCDF4C)) {
+    return;
+  }
+
+  int stat = 0, varid = -1;
+
+  stat = PIOc_inq_varid(m_file_id, name.c_str(), &varid);
+  check(PISM_ERROR_LOCATION, stat);
+
+  std::vector<PIO_Offset> chunk_sizes(dimensions.begin(), dimensions.end());
+
+  stat = PIOc_def_var_chunking(m_file_id, varid, NC_CHUNKED, chunk_sizes.data());
+  check(PISM_ERROR_LOCATION, stat);
 }
 
 void ParallelIO::get_vara_double_impl(const std::string &variable_name,
@@ -351,6 +362,14 @@ void ParallelIO::inq_varnatts_impl(const std::string &variable_name, int &result
   check(PISM_ERROR_LOCATION, stat);
 }
 
+void ParallelIO::inq_vartype_impl(const std::string &variable_name, io::Type &result) const {
+  nc_type tmp = NC_NAT;
+  int stat = PIOc_inq_vartype(m_file_id, get_varid(variable_name), &tmp);
+  check(PISM_ERROR_LOCATION, stat);
+
+  result = nc_type_to_pism_type(tmp);
+}
+
 void ParallelIO::inq_varid_impl(const std::string &variable_name, bool &exists) const {
   int stat, flag = -1;
 
@@ -0,0 +1,266 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>            // std::sort
+#include <cstdio>               // std::rename, std::remove
+#include <cstdlib>              // realpath()
+#include <cstring>              // std::memcpy
+#include <climits>              // PATH_MAX
+#include <ctime>                // time_t
+#include <fstream>
+#include <functional>           // std::hash
+#include <vector>
+
+#include <dirent.h>             // opendir(), readdir()
+#include <fcntl.h>              // open()
+#include <sys/mman.h>           // mmap()
+#include <sys/stat.h>           // stat(), futimens()
+#include <unistd.h>             // close(), getpid()
+
+#include "pism/util/io/RecordCache.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+namespace io {
+
+//! Identifies a cache file (and the version of its format).
+static const char magic[] = "PISM record cache v1";
+
+/*!
+ * Return a fingerprint of the file `filename`: its absolute path, size and modification time.
+ *
+ * Returns an empty string if the file cannot be found.
+ */
+static std::string fingerprint(const std::string &filename) {
+  char resolved_path[PATH_MAX];
+  if (realpath(filename.c_str(), resolved_path) == NULL) {
+    return "";
+  }
+
+  struct stat info;
+  if (stat(resolved_path, &info) != 0) {
+    return "";
+  }
+
+  return pism::printf("%s:%lld:%lld", resolved_path, (long long)info.st_size,
+                      (long long)info.st_mtime);
+}
+
+RecordCache::RecordCache(const Grid &grid, const std::string &directory, double max_size,
+                         const std::string &filename, const std::string &variable_name,
+                         const std::string &units, InterpolationType interpolation_type)
+  : m_grid(grid), m_directory(directory), m_max_size(max_size), m_size(0), m_modified(false) {
+
+  if (m_directory.empty()) {
+    return;
+  }
+
+  auto file = fingerprint(filename);
+  if (file.empty()) {
+    // this file is probably not on a local file system: disable caching
+    m_directory.clear();
+    return;
+  }
+
+  m_size = (size_t)grid.xm() * (size_t)grid.ym();
+
+  const auto &x = grid.x();
+  const auto &y = grid.y();
+
+  m_key = pism::printf("%s|%s|%s|%d|%d,%d,%.17g,%.17g,%.17g,%.17g|%d,%d,%d,%d", file.c_str(),
+                       variable_name.c_str(), units.c_str(), (int)interpolation_type,
+                       (int)grid.Mx(), (int)grid.My(), x.front(), x.back(), y.front(), y.back(),
+                       grid.xs(), grid.xm(), grid.ys(), grid.ym());
+}
+
+RecordCache::~RecordCache() {
+  if (m_modified) {
+    try {
+      limit_size();
+    } catch (...) {
+      // ignore errors: the cache is an optimization
+    }
+  }
+}
+
+//! True if caching is enabled.
+bool RecordCache::enabled() const {
+  return not m_directory.empty();
+}
+
+std::string RecordCache::key(unsigned int record) const {
+  return pism::printf("%s|%u", m_key.c_str(), record);
+}
+
+std::string RecordCache::path(const std::string &key) const {
+  return pism::printf("%s/pism-%016zx.bin", m_directory.c_str(), std::hash<std::string>{}(key));
+}
+
+/*!
+ * Read the record `record` into `output` (an array of `grid.xm() * grid.ym()` values).
+ *
+ * Returns `true` if *all* processes found this record in the cache, `false` otherwise. In
+ * the latter case the caller has to read the record from the input file on all processes.
+ */
+bool RecordCache::read(unsigned int record, double *output) const {
+  if (not enabled()) {
+    return false;
+  }
+
+  auto record_key = key(record);
+  auto header_size = sizeof(magic) + record_key.size();
+  auto file_size = header_size + m_size * sizeof(double);
+
+  double success = 0.0;
+
+  int fd = open(path(record_key).c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat info;
+    if (fstat(fd, &info) == 0 and (size_t)info.st_size == file_size) {
+      void *data = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+
+      if (data != MAP_FAILED) {
+        const char *bytes = static_cast<const char*>(data);
+
+        // check the header to guard against hash collisions
+        if (std::memcmp(bytes, magic, sizeof(magic)) == 0 and
+            record_key.compare(0, record_key.size(), bytes + sizeof(magic),
+                               record_key.size()) == 0) {
+          std::memcpy(output, bytes + header_size, m_size * sizeof(double));
+          success = 1.0;
+        }
+        munmap(data, file_size);
+      }
+    }
+    if (success > 0.0) {
+      // mark this file as recently used (see limit_size())
+      futimens(fd, nullptr);
+    }
+    close(fd);
+  }
+
+  return GlobalMin(m_grid.com, success) > 0.0;
+}
+
+/*!
+ * Store the record `record` in the cache.
+ *
+ * Writes to a temporary file and renames it so that other processes never see an incomplete
+ * file. Failures are ignored: the cache is an optimization.
+ */
+void RecordCache::write(unsigned int record, const double *input) const {
+  if (not enabled()) {
+    return;
+  }
+
+  auto record_key = key(record);
+  auto filename = path(record_key);
+  auto tmp_filename = pism::printf("%s.%d.tmp", filename.c_str(), (int)getpid());
+
+  {
+    std::ofstream output(tmp_filename, std::ios::binary);
+
+    output.write(magic, sizeof(magic));
+    output.write(record_key.data(), (std::streamsize)record_key.size());
+    output.write(reinterpret_cast<const char*>(input),
+                 (std::streamsize)(m_size * sizeof(double)));
+
+    if (not output.good()) {
+      output.close();
+      std::remove(tmp_filename.c_str());
+      return;
+    }
+  }
+
+  if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    std::remove(tmp_filename.c_str());
+    return;
+  }
+
+  m_modified = true;
+}
+
+/*!
+ * Remove least recently used cache files until their total size does not exceed the limit.
+ *
+ * Files are ordered by modification time, which is updated by read(). Other processes
+ * using the same directory may remove files at the same time; failures are ignored.
+ */
+void RecordCache::limit_size() const {
+  if (not enabled() or not(m_max_size > 0.0)) {
+    return;
+  }
+
+  struct CacheFile {
+    std::string path;
+    time_t mtime;
+    double size;
+  };
+
+  std::vector<CacheFile> files;
+  double total_size = 0.0;
+
+  DIR *dir = opendir(m_directory.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+
+  struct dirent *entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string name = entry->d_name;
+
+    // skip files that were not created by write() (including temporary files)
+    if (not(name.size() > 9 and name.compare(0, 5, "pism-") == 0 and
+            name.compare(name.size() - 4, 4, ".bin") == 0)) {
+      continue;
+    }
+
+    auto filename = m_directory + "/" + name;
+
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0) {
+      continue;
+    }
+
+    files.push_back({ filename, info.st_mtime, (double)info.st_size });
+    total_size += (double)info.st_size;
+  }
+  closedir(dir);
+
+  if (total_size <= m_max_size) {
+    return;
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const CacheFile &a, const CacheFile &b) { return a.mtime < b.mtime; });
+
+  for (const auto &f : files) {
+    if (total_size <= m_max_size) {
+      break;
+    }
+
+    if (std::remove(f.path.c_str()) == 0) {
+      total_size -= f.size;
+    }
+  }
+}
+
+} // end of namespace io
+} // end of namespace pism
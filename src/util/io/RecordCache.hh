@@ -0,0 +1,84 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_RECORDCACHE_H
+#define PISM_RECORDCACHE_H
+
+#include <string>
+
+#include "pism/util/interpolation.hh" // InterpolationType
+
+namespace pism {
+
+class Grid;
+
+namespace io {
+
+/*!
+ * Node-local cache of regridded records of 2D time-dependent input fields.
+ *
+ * Reading a record of a forcing field means decoding it (possibly decompressing) and
+ * interpolating it onto the computational grid. This class stores the result (the part owned
+ * by the current process) in a binary file so that later runs using the same input file, the
+ * same variable and the same grid and domain decomposition (e.g. members of an ensemble or a
+ * sequence of restarts) can memory-map it instead. Processes sharing a node share the pages
+ * of these files in the operating system's page cache.
+ *
+ * Cache files are identified by a fingerprint of the input file (its absolute path, size and
+ * modification time), the variable name and units, the grid, the part of the grid owned by
+ * this process and the record index.
+ *
+ * Reading a file from the cache updates its modification time. If this object wrote at least
+ * one file, its destructor removes least recently used cache files until their total size
+ * does not exceed `max_size` (if `max_size` is positive).
+ *
+ * All methods except `write()` are collective.
+ */
+class RecordCache {
+public:
+  RecordCache(const Grid &grid, const std::string &directory, double max_size,
+              const std::string &filename, const std::string &variable_name,
+              const std::string &units, InterpolationType interpolation_type);
+  ~RecordCache();
+
+  bool enabled() const;
+
+  bool read(unsigned int record, double *output) const;
+  void write(unsigned int record, const double *input) const;
+private:
+  std::string key(unsigned int record) const;
+  std::string path(const std::string &key) const;
+  void limit_size() const;
+
+  const Grid &m_grid;
+  std::string m_directory;
+  //! maximum total size of cache files, in bytes (zero: no limit)
+  double m_max_size;
+  //! part of the cache key common to all records
+  std::string m_key;
+  //! number of values stored by this process
+  size_t m_size;
+  //! true if write() added a file to the cache
+  mutable bool m_modified;
+};
+
+} // end of namespace io
+} // end of namespace pism
+
+#endif /* PISM_RECORDCACHE_H */
@@ -0,0 +1,183 @@
+// Copyright (C) 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "Measures write bandwidth of 2D and 3D fields for each I/O backend and chunking policy.\n\n";
+
+#include <cmath>
+#include <mpi.h>
+
+#include "pism/util/Context.hh"
+#include "pism/util/ConfigInterface.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/Logger.hh"
+#include "pism/util/Time.hh"
+#include "pism/util/array/Array3D.hh"
+#include "pism/util/array/Scalar.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/io/File.hh"
+#include "pism/util/io/io_helpers.hh"
+#include "pism/util/petscwrappers/PetscInitializer.hh"
+#include "pism/util/pism_options.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+
+//! Fill `output` with a smooth field that is not trivially compressible.
+static void fill(array::Scalar &output) {
+  auto grid = output.grid();
+
+  array::AccessScope list(output);
+  for (auto p = grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    output(i, j) = std::sin(0.01 * i) * std::cos(0.02 * j) + 1e-3 * (i + j);
+  }
+}
+
+//! Fill `output` with a smooth field that is not trivially compressible.
+static void fill(array::Array3D &output) {
+  auto grid = output.grid();
+  auto Mz   = output.levels().size();
+
+  array::AccessScope list(output);
+  for (auto p = grid->points(); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    double *column = output.get_column(i, j);
+    for (size_t k = 0; k < Mz; ++k) {
+      column[k] = std::sin(0.01 * i) * std::cos(0.02 * j) + 1e-3 * (double)k;
+    }
+  }
+}
+
+/*!
+ * Write `n_records` records of `field_2d` and `field_3d` to `filename` using `backend`.
+ *
+ * Returns the time spent, in seconds.
+ */
+static double write_fields(const Context &ctx, const std::string &filename,
+                           io::Backend backend, int n_records,
+                           const array::Scalar &field_2d, const array::Array3D &field_3d) {
+  MPI_Comm com = ctx.com();
+
+  double start = get_time(com);
+  {
+    File file(com, filename, backend, io::PISM_READWRITE_MOVE, ctx.pio_iosys_id());
+
+    io::define_time(file, ctx);
+    for (int k = 0; k < n_records; ++k) {
+      io::append_time(file, *ctx.config(), (double)k);
+
+      field_2d.write(file);
+      field_3d.write(file);
+    }
+    file.close();
+  }
+  // wait for all ranks to finish writing
+  MPI_Barrier(com);
+
+  return get_time(com) - start;
+}
+
+} // end of namespace pism
+
+int main(int argc, char *argv[]) {
+  using namespace pism;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  try {
+    auto ctx = context_from_options(com, "io_benchmark");
+    auto log = ctx->log();
+    auto config = ctx->config();
+
+    std::string usage =
+      "  io_benchmark [-Mx N -My N -Mz N] [-backends LIST] [-policies LIST] [-records N] [-prefix PREFIX]\n"
+      "where\n"
+      "  -backends   comma-separated list of I/O backends (see output.format)\n"
+      "  -policies   comma-separated list of chunking policies (see output.chunking.policy)\n"
+      "  -records    number of records to write\n"
+      "  -prefix     prefix of output file names\n";
+
+    bool done = show_usage_check_req_opts(*log, "IO_BENCHMARK (I/O write bandwidth benchmark)",
+                                          {}, usage);
+    if (done) {
+      return 0;
+    }
+
+    options::String backends("-backends", "I/O backends to test",
+                             "netcdf3,netcdf4_serial,netcdf4_parallel,pnetcdf,"
+                             "pio_netcdf,pio_netcdf4c,pio_netcdf4p,pio_pnetcdf");
+    options::String policies("-policies", "chunking policies to test",
+                             "library,decomposition,field");
+    options::Integer n_records("-records", "number of records to write", 5);
+    options::String prefix("-prefix", "prefix of output file names", "io_benchmark");
+
+    auto grid = Grid::FromOptions(ctx);
+
+    array::Scalar field_2d(grid, "field_2d");
+    field_2d.metadata(0).long_name("2D field used by the I/O benchmark").units("1");
+
+    array::Array3D field_3d(grid, "field_3d", array::WITHOUT_GHOSTS, grid->z());
+    field_3d.metadata(0).long_name("3D field used by the I/O benchmark").units("1");
+
+    fill(field_2d);
+    fill(field_3d);
+
+    const double
+      megabyte = pow(2, 20),
+      Mx       = grid->Mx(),
+      My       = grid->My(),
+      Mz       = grid->Mz(),
+      size     = (double)n_records * Mx * My * (1.0 + Mz),
+      mb       = static_cast<double>(sizeof(double)) * size / megabyte;
+
+    log->message(1, "Writing %d records of a %d x %d x %d grid (%.1f MiB) using %d processes\n",
+                 n_records.value(), (int)Mx, (int)My, (int)Mz, mb,
+                 (int)grid->size());
+    log->message(1, "%20s  %14s  %10s  %10s\n", "backend", "chunking", "time (s)", "MiB/s");
+
+    for (const auto &backend : split(backends, ',')) {
+      for (const auto &policy : split(policies, ',')) {
+        config->set_string("output.chunking.policy", policy);
+
+        auto filename = pism::printf("%s_%s_%s.nc", prefix->c_str(), backend.c_str(),
+                                     policy.c_str());
+        try {
+          double time_spent = write_fields(*ctx, filename, string_to_backend(backend),
+                                           n_records, field_2d, field_3d);
+
+          log->message(1, "%20s  %14s  %10.3f  %10.1f\n", backend.c_str(), policy.c_str(),
+                       time_spent, mb / time_spent);
+        } catch (RuntimeError &e) {
+          // this backend is not available in this build
+          log->message(1, "%20s  %14s  %10s  %10s\n", backend.c_str(), policy.c_str(), "--",
+                       "--");
+          log->message(2, "  (%s)\n", e.what());
+        }
+      }
+    }
+  } catch (...) {
+    handle_fatal_errors(com);
+    return 1;
+  }
+
+  return 0;
+}
@@ -21,6 +21,7 @@
 #include <cmath> // isfinite
 #include <cstddef>
 #include <memory>
+#include <algorithm>             // std::min, std::max
 #include <array>
 #include <vector>
 
@@ -72,6 +73,16 @@ static void regrid(const Grid &grid, const LocalInterpCtx &lic, double const *in
   // array sizes for mapping from logical to "flat" indices
   int x_count = lic.count[X], z_count = lic.count[Z];
 
+  // Indices and weights used to interpolate in the vertical direction are the same in all
+  // columns: copy them to contiguous arrays used in the inner loop below.
+  std::vector<int> Z_m(nlevels), Z_p(nlevels);
+  std::vector<double> alpha_z(nlevels);
+  for (unsigned int k = 0; k < nlevels; k++) {
+    Z_m[k]     = lic.z->left(k);
+    Z_p[k]     = lic.z->right(k);
+    alpha_z[k] = lic.z->alpha(k);
+  }
+
   for (auto p = grid.points(); p; p.next()) {
     const int i_global = p.i(), j_global = p.j();
 
@@ -81,54 +92,52 @@ static void regrid(const Grid &grid, const LocalInterpCtx &lic, double const *in
     const int X_m = lic.x->left(i), X_p = lic.x->right(i), Y_m = lic.y->left(j),
               Y_p = lic.y->right(j);
 
-    for (unsigned int k = 0; k < nlevels; k++) {
-
-      double a_mm = 0.0, a_mp = 0.0, a_pm = 0.0, a_pp = 0.0;
+    // interpolation coefficient in the x direction
+    const double x_alpha = lic.x->alpha(i);
+    // interpolation coefficient in the y direction
+    const double y_alpha = lic.y->alpha(j);
 
-      if (nlevels > 1) {
-        const int Z_m = lic.z->left(k), Z_p = lic.z->right(k);
+    // the column at (x,y) in the output array
+    double *output = &output_array[(j * grid.xm() + i) * nlevels];
 
-        const double alpha_z = lic.z->alpha(k);
+    if (nlevels > 1) {
+      // We pretend that there are always 8 neighbors (4 in the map plane, 2 vertical
+      // levels). Columns containing these neighbors are contiguous in the input_array.
+      const double *c_mm = &input_array[(Y_m * x_count + X_m) * z_count],
+                   *c_mp = &input_array[(Y_m * x_count + X_p) * z_count],
+                   *c_pm = &input_array[(Y_p * x_count + X_m) * z_count],
+                   *c_pp = &input_array[(Y_p * x_count + X_p) * z_count];
 
-        // We pretend that there are always 8 neighbors (4 in the map plane,
-        // 2 vertical levels). And compute the indices into the input_array for
-        // those neighbors.
-        const int mmm = (Y_m * x_count + X_m) * z_count + Z_m,
-                  mmp = (Y_m * x_count + X_m) * z_count + Z_p,
-                  mpm = (Y_m * x_count + X_p) * z_count + Z_m,
-                  mpp = (Y_m * x_count + X_p) * z_count + Z_p,
-                  pmm = (Y_p * x_count + X_m) * z_count + Z_m,
-                  pmp = (Y_p * x_count + X_m) * z_count + Z_p,
-                  ppm = (Y_p * x_count + X_p) * z_count + Z_m,
-                  ppp = (Y_p * x_count + X_p) * z_count + Z_p;
+      for (unsigned int k = 0; k < nlevels; k++) {
+        const int m = Z_m[k], n = Z_p[k];
+        const double a = alpha_z[k];
 
         // linear interpolation in the z-direction
-        a_mm = input_array[mmm] * (1.0 - alpha_z) + input_array[mmp] * alpha_z;
-        a_mp = input_array[mpm] * (1.0 - alpha_z) + input_array[mpp] * alpha_z;
-        a_pm = input_array[pmm] * (1.0 - alpha_z) + input_array[pmp] * alpha_z;
-        a_pp = input_array[ppm] * (1.0 - alpha_z) + input_array[ppp] * alpha_z;
-      } else {
-        // we don't need to interpolate vertically for the 2-D case
-        a_mm = input_array[Y_m * x_count + X_m];
-        a_mp = input_array[Y_m * x_count + X_p];
-        a_pm = input_array[Y_p * x_count + X_m];
-        a_pp = input_array[Y_p * x_count + X_p];
-      }
+        const double a_mm = c_mm[m] * (1.0 - a) + c_mm[n] * a;
+        const double a_mp = c_mp[m] * (1.0 - a) + c_mp[n] * a;
+        const double a_pm = c_pm[m] * (1.0 - a) + c_pm[n] * a;
+        const double a_pp = c_pp[m] * (1.0 - a) + c_pp[n] * a;
+
+        // interpolate in x direction
+        const double a_m = a_mm * (1.0 - x_alpha) + a_mp * x_alpha;
+        const double a_p = a_pm * (1.0 - x_alpha) + a_pp * x_alpha;
 
-      // interpolation coefficient in the x direction
-      const double x_alpha = lic.x->alpha(i);
-      // interpolation coefficient in the y direction
-      const double y_alpha = lic.y->alpha(j);
+        // interpolate in y direction
+        output[k] = a_m * (1.0 - y_alpha) + a_p * y_alpha;
+      }
+    } else {
+      // we don't need to interpolate vertically for the 2-D case
+      const double a_mm = input_array[Y_m * x_count + X_m];
+      const double a_mp = input_array[Y_m * x_count + X_p];
+      const double a_pm = input_array[Y_p * x_count + X_m];
+      const double a_pp = input_array[Y_p * x_count + X_p];
 
       // interpolate in x direction
       const double a_m = a_mm * (1.0 - x_alpha) + a_mp * x_alpha;
       const double a_p = a_pm * (1.0 - x_alpha) + a_pp * x_alpha;
 
-      int index = (j * grid.xm() + i) * nlevels + k;
-
-      // index into the new array and interpolate in x direction
-      output_array[index] = a_m * (1.0 - y_alpha) + a_p * y_alpha;
-      // done with the point at (x,y,z)
+      // interpolate in y direction
+      output[0] = a_m * (1.0 - y_alpha) + a_p * y_alpha;
     }
   }
 }
@@ -434,6 +443,11 @@ static std::vector<double> read_for_interpolation(const File &file,
     auto sc = compute_start_and_count(dim_types, lic.start, lic.count);
 
     if (use_transposed_io(dim_types)) {
+      internal_grid.ctx()->log()->message(
+          3, "  '%s' in '%s' does not use PISM's storage order (time, y, x, z);\n"
+             "  reading it requires transposition (use ncpdq to avoid it)\n",
+          variable_name.c_str(), file.filename().c_str());
+
       file.read_variable_transposed(variable_name, sc.start, sc.count, sc.imap, buffer.data());
     } else {
       file.read_variable(variable_name, sc.start, sc.count, buffer.data());
@@ -463,6 +477,111 @@ static std::vector<double> read_for_interpolation(const File &file,
   }
 }
 
+/*!
+ * Chunk length along one horizontal direction for the "decomposition" policy.
+ *
+ * Returns the greatest common divisor of sub-domain widths `procs`: then every sub-domain
+ * boundary is a chunk boundary. If the domain is split unevenly (e.g. [34, 33, 33]) the
+ * GCD may be too small to be useful; in this case use the widest sub-domain instead and
+ * accept that some writes straddle chunk boundaries.
+ */
+static size_t decomposition_chunk(const std::vector<unsigned int> &procs, size_t length) {
+  size_t gcd = 0, min_width = length, max_width = 0;
+  for (auto w : procs) {
+    size_t a = gcd, b = w;
+    while (b != 0) {
+      size_t r = a % b;
+      a        = b;
+      b        = r;
+    }
+    gcd       = a;
+    min_width = std::min(min_width, (size_t)w);
+    max_width = std::max(max_width, (size_t)w);
+  }
+
+  size_t result = (2 * gcd >= min_width) ? gcd : max_width;
+
+  return std::max((size_t)1, std::min(length, result));
+}
+
+/*!
+ * Compute chunk sizes for a spatial variable with dimensions `[time,] y, x [, z]`.
+ *
+ * - "decomposition": chunk boundaries match sub-domain boundaries (see
+ *   decomposition_chunk()), so that parallel writes do not straddle chunk boundaries;
+ * - "field": one chunk per record.
+ *
+ * Chunks span the whole vertical column and contain at most `max_chunk_size` bytes (HDF5
+ * does not support chunks of 4 GiB or more). Larger chunks are split along `z` first (this
+ * keeps them aligned with sub-domains), then along `y` and `x`.
+ *
+ * @param[in] policy chunking policy ("decomposition" or "field")
+ * @param[in] procs_x widths of sub-domains in the `x` direction
+ * @param[in] procs_y widths of sub-domains in the `y` direction
+ * @param[in] time_dependent true if the variable has the time dimension
+ * @param[in] y_length length of the `y` dimension
+ * @param[in] x_length length of the `x` dimension
+ * @param[in] z_length length of the `z` dimension (zero if there is none)
+ * @param[in] element_size size of one value, in bytes
+ * @param[in] max_chunk_size maximum chunk size, in bytes
+ */
+std::vector<size_t> chunk_dimensions(const std::string &policy,
+                                     const std::vector<unsigned int> &procs_x,
+                                     const std::vector<unsigned int> &procs_y,
+                                     bool time_dependent, size_t y_length, size_t x_length,
+                                     size_t z_length, size_t element_size,
+                                     size_t max_chunk_size) {
+  size_t y_chunk = y_length, x_chunk = x_length, z_chunk = std::max((size_t)1, z_length);
+
+  if (policy == "decomposition") {
+    x_chunk = decomposition_chunk(procs_x, x_length);
+    y_chunk = decomposition_chunk(procs_y, y_length);
+  }
+
+  // maximum number of values in a chunk
+  size_t N = std::max((size_t)1, max_chunk_size / std::max((size_t)1, element_size));
+
+  if (y_chunk * x_chunk * z_chunk > N) {
+    z_chunk = std::max((size_t)1, N / (y_chunk * x_chunk));
+  }
+  if (y_chunk * x_chunk * z_chunk > N) {
+    y_chunk = std::max((size_t)1, N / (x_chunk * z_chunk));
+  }
+  if (y_chunk * x_chunk * z_chunk > N) {
+    x_chunk = std::max((size_t)1, N / (y_chunk * z_chunk));
+  }
+
+  std::vector<size_t> result;
+  if (time_dependent) {
+    result.push_back(1);
+  }
+
+  result.push_back(y_chunk);
+  result.push_back(x_chunk);
+
+  if (z_length > 0) {
+    result.push_back(z_chunk);
+  }
+
+  return result;
+}
+
+//! Size of a value of type `type`, in bytes.
+size_t type_size(io::Type type) {
+  switch (type) {
+  case PISM_BYTE:
+  case PISM_CHAR:
+    return 1;
+  case PISM_SHORT:
+    return 2;
+  case PISM_INT:
+  case PISM_FLOAT:
+    return 4;
+  default:
+    return 8;
+  }
+}
+
 //! Define a NetCDF variable corresponding to a VariableMetadata object.
 void define_spatial_variable(const SpatialVariableMetadata &metadata, const Grid &grid,
                              const File &file, io::Type default_type) {
@@ -505,6 +624,20 @@ void define_spatial_variable(const SpatialVariableMetadata &metadata, const Grid
   }
   file.define_variable(name, type, dims);
 
+  auto policy = config->get_string("output.chunking.policy");
+  if (policy != "library") {
+    size_t z_length = z.empty() ? 0 : file.dimension_length(z);
+
+    size_t max_chunk_size =
+        static_cast<size_t>(config->get_number("output.chunking.max_size")) * 1024 * 1024;
+
+    file.define_chunking(name, chunk_dimensions(policy, grid.procs_x(), grid.procs_y(),
+                                                not var.get_time_independent(),
+                                                file.dimension_length(y),
+                                                file.dimension_length(x), z_length,
+                                                type_size(type), max_chunk_size));
+  }
+
   write_attributes(file, var, type);
 
   // add the "grid_mapping" attribute if the grid has an associated mapping. Variables lat, lon,
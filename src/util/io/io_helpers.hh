@@ -69,6 +69,15 @@ void write_spatial_variable(const SpatialVariableMetadata &metadata,
                             const Grid& grid, const File &file,
                             const double *input);
 
+std::vector<size_t> chunk_dimensions(const std::string &policy,
+                                     const std::vector<unsigned int> &procs_x,
+                                     const std::vector<unsigned int> &procs_y,
+                                     bool time_dependent, size_t y_length, size_t x_length,
+                                     size_t z_length, size_t element_size,
+                                     size_t max_chunk_size);
+
+size_t type_size(io::Type type);
+
 void define_dimension(const File &nc, unsigned long int length,
                       const VariableMetadata &metadata);
 
@@ -0,0 +1,66 @@
+// Copyright (C) 2023 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "pism/util/io/netcdf_helpers.hh"
+
+// The following is a stupid kludge necessary to make NetCDF 4.x work in
+// serial mode in an MPI program:
+#ifndef MPI_INCLUDED
+#define MPI_INCLUDED 1
+#endif
+#include <netcdf.h>
+
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+namespace io {
+
+/*!
+ * Enable lossy quantization of a floating point variable, keeping `digits` significant
+ * decimal digits.
+ *
+ * Uses the "granular bit round" algorithm. Returns NC_NOERR without doing anything if
+ * quantization is not supported, i.e. if PISM was built using NetCDF older than 4.9.0
+ * or if the format of the file `ncid` does not support it. Other errors are returned to
+ * the caller.
+ */
+int define_quantization(int ncid, int varid, io::Type type, int digits) {
+#ifdef NC_QUANTIZE_GRANULARBR
+  // NetCDF limits the number of significant digits to 7 for floats and 15 for doubles
+  int max_digits = type == PISM_FLOAT ? 7 : 15;
+
+  int stat = nc_def_var_quantize(ncid, varid, NC_QUANTIZE_GRANULARBR,
+                                 pism::clip(digits, 1, max_digits));
+
+  // Quantization is supported by NetCDF-4 (HDF5-based) files only.
+  if (stat == NC_ENOTNC4) {
+    stat = NC_NOERR;
+  }
+
+  return stat;
+#else
+  (void) ncid;
+  (void) varid;
+  (void) type;
+  (void) digits;
+  return NC_NOERR;
+#endif
+}
+
+} // end of namespace io
+} // end of namespace pism
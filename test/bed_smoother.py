@@ -89,10 +89,11 @@ def smooth(topg, topg_smoothed, usurf, theta):
     topg_smoothed.copy_from(smoother.smoothed_bed())
 
 
-def run():
+def run(method="serial"):
     "Run the bed smoother using synthetic geometry."
 
     set_config()
+    config.set_string("stress_balance.sia.bed_smoother.method", method)
 
     topg, topg_smoothed, usurf, theta = allocate_storage(grid())
 
@@ -108,6 +109,8 @@ def run():
 def bed_smoother_test():
     "Compare the range of topg, topg_smoothed, and theta to stored values"
 
+    # stored values were computed using the serial implementation
+
     topg, topg_smoothed, usurf, theta = run()
 
     stored_range = {}
@@ -127,6 +130,19 @@ def bed_smoother_test():
             assert abs(computed[k] - stored[k]) < 1e-16
 
 
+def bed_smoother_parallel_test():
+    "Compare results of parallel and serial implementations"
+
+    _, serial_smoothed, _, serial_theta = run("serial")
+    _, parallel_smoothed, _, parallel_theta = run("parallel")
+
+    for serial, parallel in [(serial_smoothed, parallel_smoothed),
+                             (serial_theta, parallel_theta)]:
+        scale = max(abs(x) for x in serial.range())
+        diff = serial.numpy() - parallel.numpy()
+        assert abs(diff).max() / scale < 1e-12
+
+
 if __name__ == "__main__":
     for field in run():
         field.dump("bed_smoother_%s.nc" % field.get_name())
@@ -454,6 +454,38 @@ class TestXZ(TestCase):
 
         show(f)
 
+class TestXZMatrixFree(TestXZ):
+    """Verification test XZ using the matrix-free Jacobian on the finest multigrid level.
+
+    The finest level smoother uses the diagonal of the Jacobian only, so this test uses
+    two multigrid levels and the Jacobi preconditioner.
+    """
+    def setUp(self):
+        TestXZ.setUp(self)
+
+        config.set_flag("stress_balance.blatter.matrix_free", True)
+
+        mf_opts = {"-bp_mg_levels_pc_type": "jacobi"}
+
+        for k, v in mf_opts.items():
+            self.opt.setValue(k, v)
+
+        self.opts.update(mf_opts)
+
+    def test(self):
+        "Test that the convergence rate for the XZ test is at least quadratic (matrix-free)"
+
+        Ns = [21, 41]
+        mg_levels = [2, 2]
+
+        norms = [self.error_norm(N, n_mg) for (N, n_mg) in zip(Ns, mg_levels)]
+
+        expt_u = expt(Ns, norms)
+
+        print("U component conv. rate: dx^{}".format(expt_u))
+
+        assert expt_u >= 2.0
+
 class TestCFBC(TestCase):
     """Constant viscosity 2D (x-z) verification test checking the implementation of CFBC.
 
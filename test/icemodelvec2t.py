@@ -243,6 +243,20 @@ class ForcingInput(unittest.TestCase):
         with PISM.vec.Access(nocomm=forcing):
             numpy.testing.assert_almost_equal(forcing.interp(0, 0), self.f)
 
+    def test_interp_linear_2(self):
+        "Linear interpolation using init_interpolation(ts) and interp(i, j)"
+        F = self.forcing(self.interp_linear, interpolation_type=PISM.LINEAR)
+        F.update(0, 4)
+
+        # several times in each interval between records, plus constant extrapolation
+        ts = [0.5, 1.0, 1.25, 1.5, 2.0, 2.5, 2.75, 3.0, 3.5]
+        vs = [2.0, 2.0, 0.5, -1.0, -4.0, -0.5, 1.25, 3.0, 3.0]
+
+        F.init_interpolation(ts)
+
+        with PISM.vec.Access(nocomm=F):
+            numpy.testing.assert_almost_equal(F.interp(0, 0), vs)
+
     def test_one_record(self):
         "Input file with only one time record"
         forcing = self.forcing(self.one_record)
@@ -343,6 +357,62 @@ class ForcingInput(unittest.TestCase):
         # fourth month
         check(3)
 
+    def test_cache(self):
+        "reading records from the forcing cache"
+        import tempfile, shutil
+
+        directory = tempfile.mkdtemp()
+        max_size = ctx.config.get_number("input.forcing.cache_max_size")
+
+        def cache_files():
+            return sorted(os.path.join(directory, f) for f in os.listdir(directory))
+
+        def read():
+            forcing = self.forcing(self.filename, buffer_size=3)
+
+            for month in [1, 3, 7]:
+                t = seconds(self.tb[month]) + 1
+                forcing.update(t, seconds(1))
+                forcing.interp(t)
+
+                compare(forcing, self.f[month])
+
+        ctx.config.set_string("input.forcing.cache_directory", directory)
+        try:
+            # the first pass populates the cache
+            read()
+            files = cache_files()
+            assert len(files) > 0
+
+            # mark all files as "old": reading a record from the cache updates the
+            # modification time of its file
+            inodes = {}
+            for f in files:
+                os.utime(f, (1, 1))
+                inodes[f] = os.stat(f).st_ino
+
+            # the second pass reads all records from the cache: files are not re-created
+            read()
+            assert cache_files() == files
+            for f in files:
+                info = os.stat(f)
+                assert info.st_ino == inodes[f]
+                assert info.st_mtime > 1
+
+            # least recently used files are removed if the cache grows beyond the limit
+            # (cache files have nearly the same size here)
+            file_size = os.stat(files[0]).st_size
+            for f in files:
+                os.remove(f)
+
+            ctx.config.set_number("input.forcing.cache_max_size", 2.5 * file_size / 2**20)
+            read()
+            assert 0 < len(cache_files()) <= 2
+        finally:
+            ctx.config.set_string("input.forcing.cache_directory", "")
+            ctx.config.set_number("input.forcing.cache_max_size", max_size)
+            shutil.rmtree(directory)
+
     def test_max_timestep(self):
         "Maximum time step"
         forcing = self.forcing(self.filename, buffer_size=1)
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+
+"""Tests of the isochrone tracing model: growing storage for layer thicknesses in blocks
+and merging thin layers.
+"""
+
+import PISM
+from PISM.testing import shallow_grid
+import numpy as np
+
+ctx = PISM.Context()
+ctx.log.set_threshold(1)
+
+config = ctx.config
+time = ctx.time
+
+N_years = 20
+# initial ice thickness
+H0 = 100.0
+
+time.set_start(0.0)
+time.set(0.0)
+time.set_end(PISM.util.convert(N_years, "year", "second"))
+
+config.set_string("isochrones.deposition_times", "yearly")
+config.set_number("isochrones.bootstrapping.n_layers", 0)
+
+def run(block_size, max_thickness):
+    """Run the isochrone tracing model with zero velocity and a spatially-variable top
+    surface mass balance.
+
+    Returns layer thicknesses, isochrone depths and the top surface mass balance per time
+    step.
+    """
+    config.set_number("isochrones.block_size", block_size)
+    config.set_number("isochrones.merge.max_thickness", max_thickness)
+
+    grid = shallow_grid(Mx=5, My=5)
+
+    u = PISM.Array3D(grid, "u", PISM.WITH_GHOSTS, grid.z())
+    v = PISM.Array3D(grid, "v", PISM.WITH_GHOSTS, grid.z())
+    u.set(0.0)
+    v.set(0.0)
+
+    # top surface mass balance per time step, in meters
+    smb = PISM.Scalar(grid, "smb")
+    with PISM.vec.Access(nocomm=[smb]):
+        for (i, j) in grid.points():
+            smb[i, j] = 0.1 + 0.05 * ((i + 2 * j) % 5)
+
+    bmb = PISM.Scalar(grid, "bmb")
+    bmb.set(0.0)
+
+    ice_thickness = PISM.Scalar(grid, "thk")
+    ice_thickness.set(H0)
+
+    model = PISM.Isochrones(grid, None)
+    model.bootstrap(ice_thickness)
+
+    times = list(model.deposition_times())
+    assert len(times) > 3 * block_size
+
+    for t0, t1 in zip(times[:-1], times[1:]):
+        ice_thickness.add(1.0, smb)
+        model.update(t0, t1 - t0, u, v, ice_thickness, smb, bmb)
+
+    diagnostics = model.diagnostics()
+    thickness = diagnostics["isochronal_layer_thickness"].compute().numpy()
+    depth = diagnostics["isochrone_depth"].compute().numpy()
+
+    return thickness, depth, smb.numpy()
+
+def block_allocation_test():
+    "Layer storage grows past isochrones.block_size"
+
+    thickness, depth, smb = run(block_size=3, max_thickness=0.0)
+    N = thickness.shape[2]
+
+    # each layer receives the SMB of one time step; the bottom one also contains the
+    # initial ice thickness and the top one was just added
+    expected = np.zeros_like(thickness)
+    for k in range(N - 1):
+        expected[:, :, k] = smb
+    expected[:, :, 0] += H0
+
+    np.testing.assert_allclose(thickness, expected, rtol=1e-12)
+    np.testing.assert_allclose(depth[:, :, 0], H0 + (N - 1) * smb, rtol=1e-12)
+
+    # results should not depend on the block size
+    thickness_large_block, _, _ = run(block_size=100, max_thickness=0.0)
+    np.testing.assert_equal(thickness, thickness_large_block)
+
+def merging_test():
+    "Merged isochrones are within isochrones.merge.max_thickness of their unmerged depths"
+
+    max_thickness = 1.0
+
+    thickness, depth, smb = run(block_size=3, max_thickness=0.0)
+    thickness_merged, depth_merged, _ = run(block_size=3, max_thickness=max_thickness)
+
+    # total thickness is not affected by merging
+    np.testing.assert_allclose(depth_merged[:, :, 0], depth[:, :, 0], rtol=1e-12)
+    np.testing.assert_allclose(np.sum(thickness_merged, axis=2), np.sum(thickness, axis=2),
+                               rtol=1e-12)
+
+    error = np.abs(depth_merged - depth)
+
+    # some layers were merged...
+    assert np.max(error) > 0.0
+    # ... and some were removed (reported with zero thickness)
+    assert np.sum(np.max(thickness_merged, axis=(0, 1)) == 0.0) > 1
+
+    # isochrones removed by merging are within max_thickness of their unmerged depths
+    assert np.max(error) <= max_thickness * (1.0 + 1e-12)
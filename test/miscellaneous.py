@@ -725,6 +725,108 @@ def ssa_trivial_test():
     finally:
         os.remove(output_file)
 
+def ssa_adaptive_test():
+    "Test re-using the SSA velocity in the adaptive mode"
+    import re
+
+    config = ctx.config
+
+    def report(ssa):
+        "Return (re-used, tolerance factor) using the SSA stdout report"
+        text = ssa.stdout_report()
+        factor = re.search(r"tolerance factor ([0-9.]+)", text)
+        return "re-used" in text, float(factor.group(1)) if factor else None
+
+    saved = {"stress_balance.ssa.adaptive.enabled": config.get_flag("stress_balance.ssa.adaptive.enabled"),
+             "stress_balance.ssa.dirichlet_bc": config.get_flag("stress_balance.ssa.dirichlet_bc")}
+    max_skipped = config.get_number("stress_balance.ssa.adaptive.max_skipped_steps")
+    try:
+        config.set_flag("stress_balance.ssa.adaptive.enabled", True)
+        config.set_flag("stress_balance.ssa.dirichlet_bc", True)
+        config.set_number("stress_balance.ssa.adaptive.max_skipped_steps", 1)
+        # the SSA stdout report is empty at lower verbosity levels
+        ctx.log.set_threshold(2)
+
+        Mx = 21
+        L = 50e3
+        grid = PISM.testing.shallow_grid(Mx=Mx, My=Mx, Lx=L, Ly=L)
+
+        geometry = PISM.Geometry(grid)
+        geometry.ice_thickness.set(500.0)
+        geometry.sea_level_elevation.set(-1000.0)
+        geometry.ice_area_specific_volume.set(0.0)
+        x = grid.x()
+        with PISM.vec.Access(nocomm=[geometry.bed_elevation]):
+            for (i, j) in grid.points():
+                geometry.bed_elevation[i, j] = 1e-3 * (L - x[i])
+        geometry.ensure_consistency(0.0)
+
+        tauc = PISM.Scalar(grid, "tauc")
+        tauc.set(1e4)
+
+        EC = ctx.enthalpy_converter
+        enthalpy = PISM.Array3D(grid, "enthalpy", PISM.WITH_GHOSTS)
+        enthalpy.set(EC.enthalpy(260.0, 0.0, EC.pressure(500.0)))
+
+        # zero Dirichlet B.C. at domain boundaries
+        bc_mask = PISM.Scalar(grid, "bc_mask")
+        bc_values = PISM.Vector(grid, "bc_values")
+        bc_values.set(0.0)
+        with PISM.vec.Access(nocomm=[bc_mask]):
+            for (i, j) in grid.points():
+                boundary = i in [0, Mx - 1] or j in [0, Mx - 1]
+                bc_mask[i, j] = 1.0 if boundary else 0.0
+
+        inputs = PISM.StressBalanceInputs()
+        inputs.geometry = geometry
+        inputs.basal_yield_stress = tauc
+        inputs.enthalpy = enthalpy
+        inputs.bc_mask = bc_mask
+        inputs.bc_values = bc_values
+
+        ssa = PISM.SSAFD(grid)
+        ssa.init()
+
+        ssa.update(inputs, True)
+        assert report(ssa) == (False, None)
+        u = ssa.velocity().numpy()
+
+        # inputs did not change: the velocity is re-used
+        ssa.update(inputs, True)
+        assert report(ssa)[0]
+        np.testing.assert_equal(ssa.velocity().numpy(), u)
+
+        f_min = config.get_number("stress_balance.ssa.adaptive.min_tolerance_factor")
+        f_max = config.get_number("stress_balance.ssa.adaptive.max_tolerance_factor")
+        assert f_min < 1.0
+
+        # max_skipped_steps is reached: solve again; the velocity barely changed, so the
+        # tolerance is tightened as much as allowed
+        ssa.update(inputs, True)
+        reused, factor = report(ssa)
+        assert not reused
+        np.testing.assert_allclose(factor, f_min, atol=0.005)
+
+        # changes in the ice hardness require a solve
+        enthalpy.set(EC.enthalpy(250.0, 0.0, EC.pressure(500.0)))
+        ssa.update(inputs, True)
+        reused, factor = report(ssa)
+        assert not reused
+        assert f_min - 0.005 <= factor <= f_max + 0.005
+
+        # changes in Dirichlet B.C. values require a solve
+        bc_values.set(PISM.util.convert(10.0, "m / year", "m / s"))
+        ssa.update(inputs, True)
+        assert not report(ssa)[0]
+
+        ssa.update(inputs, True)
+        assert report(ssa)[0]
+    finally:
+        for name, value in saved.items():
+            config.set_flag(name, value)
+        config.set_number("stress_balance.ssa.adaptive.max_skipped_steps", max_skipped)
+        ctx.log.set_threshold(0)
+
 def epsg_test():
     "Test EPSG to CF conversion."
     l = PISM.StringLogger(PISM.PETSc.COMM_WORLD, 2)
@@ -918,6 +1020,135 @@ def vertical_extrapolation_during_regridding_test():
     finally:
         os.remove(file_name)
 
+def compressed_3d_storage_test():
+    "Test reduced-precision storage of 3D arrays"
+    ctx = PISM.Context()
+    params = PISM.GridParameters(ctx.config)
+    params.Lx = 1e5
+    params.Ly = 1e5
+    params.Mx = 3
+    params.My = 3
+    params.Mz = 21
+    params.Lz = 1000
+    params.registration = PISM.CELL_CORNER
+    params.periodicity = PISM.NOT_PERIODIC
+    params.ownership_ranges_from_options(ctx.size)
+
+    z = np.linspace(0, params.Lz, params.Mz)
+    params.z[:] = z
+
+    grid = PISM.Grid(ctx.ctx, params)
+
+    # a smooth function of z that is not representable in single precision
+    column = 2.5e5 + 1e3 * np.sin(z / z.max() + 0.1)
+
+    for method, tolerance in [(PISM.COMPRESSION_FLOAT32, 6e-8 * np.abs(column).max()),
+                              (PISM.COMPRESSION_INT16, np.ptp(column) / 131070.0)]:
+        v = PISM.Array3D(grid, "test", PISM.WITHOUT_GHOSTS, grid.z())
+        v.set_compression(method)
+
+        with PISM.vec.Access(nocomm=[v]):
+            v.set_column(1, 1, column)
+
+        # values are packed at the end of the access scope above
+        with PISM.vec.Access(nocomm=[v]):
+            result = np.array(v.get_column(1, 1))
+
+        assert np.max(np.abs(result - column)) <= tolerance
+
+        # packing values that were already rounded should not change them
+        with PISM.vec.Access(nocomm=[v]):
+            np.testing.assert_equal(np.array(v.get_column(1, 1)), result)
+
+        # read-only access scopes should not change values
+        for k in range(3):
+            with PISM.vec.Access(nocomm=[v]):
+                np.testing.assert_equal(np.array(v.get_column(1, 1)), result)
+
+    # Values are unpacked one column at a time: use more columns than fit in the cache of
+    # unpacked columns and mix column access with operations that use the Vec shared by
+    # compressed arrays.
+    params.Mx = 7
+    params.My = 7
+    params.ownership_ranges_from_options(ctx.size)
+    grid = PISM.Grid(ctx.ctx, params)
+
+    def f(i, j):
+        return column + 10.0 * i + 100.0 * j
+
+    def check(v, g, tolerance):
+        "Check values of `v` using column access and using a copy on rank 0"
+        with PISM.vec.Access(nocomm=[v]):
+            for i, j in grid.points():
+                assert np.max(np.abs(np.array(v.get_column(i, j)) - g(i, j))) <= tolerance
+
+        values = v.numpy()
+        if values is not None:
+            for j in range(grid.My()):
+                for i in range(grid.Mx()):
+                    assert np.max(np.abs(values[j, i, :] - g(i, j))) <= tolerance
+
+    f_max = np.abs(f(grid.Mx(), grid.My())).max()
+    for method, tolerance in [(PISM.COMPRESSION_FLOAT32, 6e-8 * 3 * f_max),
+                              (PISM.COMPRESSION_INT16, 3 * np.ptp(column) / 131070.0)]:
+        a = PISM.Array3D(grid, "a", PISM.WITH_GHOSTS, grid.z())
+        b = PISM.Array3D(grid, "b", PISM.WITH_GHOSTS, grid.z())
+        for v in [a, b]:
+            v.set_compression(method)
+
+        with PISM.vec.Access(nocomm=[a, b]):
+            for i, j in grid.points():
+                a.set_column(i, j, f(i, j))
+                b.set_column(i, j, 2 * f(i, j))
+
+        check(a, f, tolerance)
+        check(b, lambda i, j: 2 * f(i, j), 2 * tolerance)
+
+        # `a` and `b` use the same shared Vec
+        a.update_ghosts()
+        a.add(1.0, b)
+        check(a, lambda i, j: 3 * f(i, j), 6 * tolerance)
+
+        b.copy_from(a)
+        check(b, lambda i, j: 3 * f(i, j), 9 * tolerance)
+
+        # operations using the shared Vec within an access scope
+        owned = grid.xs() == 0 and grid.ys() == 0
+        with PISM.vec.Access(nocomm=[a]):
+            if owned:
+                a.set_column(0, 0, np.zeros_like(column))
+            a.scale(2.0)
+            if owned:
+                np.testing.assert_equal(np.array(a.get_column(0, 0)), 0.0)
+        check(a, lambda i, j: 0.0 if (i, j) == (0, 0) else 6 * f(i, j), 12 * tolerance)
+
+    # arrays are compressed only if a model component opts in
+    config = ctx.config
+    method = config.get_string("grid.compressed_3d.method")
+    variables = config.get_string("grid.compressed_3d.variables")
+    try:
+        config.set_string("grid.compressed_3d.method", "int16")
+        config.set_string("grid.compressed_3d.variables", "test")
+
+        for opt_in in [False, True]:
+            v = PISM.Array3D(grid, "test", PISM.WITHOUT_GHOSTS, grid.z())
+            if opt_in:
+                v.enable_compression()
+
+            with PISM.vec.Access(nocomm=[v]):
+                v.set_column(1, 1, column)
+
+            with PISM.vec.Access(nocomm=[v]):
+                result = np.array(v.get_column(1, 1))
+
+            if opt_in:
+                assert np.max(np.abs(result - column)) > 0
+            else:
+                np.testing.assert_equal(result, column)
+    finally:
+        config.set_string("grid.compressed_3d.method", method)
+        config.set_string("grid.compressed_3d.variables", variables)
+
 class PrincipalStrainRates(TestCase):
     def u_exact(self, x, y):
         "Velocity field for testing"
@@ -1571,3 +1802,259 @@ def grounding_line_flux_test():
 
     NORM_INFINITY = 3
     np.testing.assert_almost_equal(gl_flux.norm(NORM_INFINITY), 0.0)
+
+def config_handles_test():
+    "ConfigNumber and ConfigFlag: cached values and unit conversions"
+    config = PISM.DefaultConfig(ctx.com, "pism_config", "-config", ctx.unit_system)
+    config.init_with_default(ctx.log)
+
+    config.set_number("time_stepping.maximum_time_step", 2.0)
+    config.set_flag("time_stepping.skip.enabled", False)
+
+    dt = PISM.ConfigNumber(config, "time_stepping.maximum_time_step", "days")
+    skip = PISM.ConfigFlag(config, "time_stepping.skip.enabled")
+
+    np.testing.assert_almost_equal(dt.value(),
+                                   config.get_number("time_stepping.maximum_time_step", "days"))
+    np.testing.assert_almost_equal(dt.value(), 2.0 * 365)
+    assert not skip.value()
+
+    # handles have to notice changes in the configuration database
+    config.set_number("time_stepping.maximum_time_step", 1.0)
+    config.set_flag("time_stepping.skip.enabled", True)
+
+    np.testing.assert_almost_equal(dt.value(),
+                                   config.get_number("time_stepping.maximum_time_step", "days"))
+    assert skip.value()
+
+def max_timestep_reduction_test():
+    "MaxTimestepReduction: combined reductions preserve descriptions"
+    reduction = PISM.MaxTimestepReduction()
+
+    rank = ctx.com.Get_rank()
+
+    a = reduction.add(PISM.MaxTimestep(1.0 + rank, "first"))
+    b = reduction.add(PISM.MaxTimestep("second"))
+    c = reduction.add_max(float(rank))
+
+    reduction.reduce(ctx.com)
+
+    assert reduction.restriction(a).value() == 1.0
+    assert reduction.restriction(a).description() == "first"
+    assert reduction.restriction(b).infinite()
+    assert reduction.restriction(b).description() == "second"
+    assert reduction.max(c) == ctx.com.Get_size() - 1
+
+def config_copy_test():
+    "NetCDFConfig.copy_from(): copies should be independent"
+    config = PISM.DefaultConfig(ctx.com, "pism_config", "-config", ctx.unit_system)
+    config.init_with_default(ctx.log)
+    config.set_number("constants.ice.density", 900.0, PISM.CONFIG_USER)
+
+    copy = PISM.DefaultConfig(ctx.com, "pism_config", "-config", ctx.unit_system)
+    copy.copy_from(config)
+
+    assert copy.get_number("constants.ice.density") == 900.0
+    assert "constants.ice.density" in copy.parameters_set_by_user()
+    # unit conversions need parameter metadata
+    np.testing.assert_almost_equal(copy.get_number("time_stepping.maximum_time_step", "days"),
+                                   config.get_number("time_stepping.maximum_time_step", "days"))
+
+    copy.set_number("constants.ice.density", 910.0)
+    assert config.get_number("constants.ice.density") == 900.0
+
+def fill_depressions_test():
+    "fill_depressions(): compare to a serial priority-flood implementation"
+    import heapq
+
+    Mx, My = 21, 17
+    grid = PISM.testing.shallow_grid(Mx=Mx, My=My)
+
+    np.random.seed(1)
+    x = np.linspace(0, 6, Mx)
+    y = np.linspace(0, 6, My)
+    X, Y = np.meshgrid(x, y)
+    Z = 100 * np.sin(2 * X) * np.cos(1.5 * Y) + np.random.normal(0, 10, (My, Mx))
+    M = np.array(Z < 80, dtype=float)
+    epsilon = 0.5
+
+    # reference implementation
+    outlet = M < 0.5
+    outlet[0, :] = outlet[-1, :] = outlet[:, 0] = outlet[:, -1] = True
+    W = np.where(outlet, Z, np.inf)
+    queue = [(W[j, i], j, i) for j, i in zip(*np.nonzero(outlet))]
+    heapq.heapify(queue)
+    done = np.zeros_like(outlet)
+    while queue:
+        w, j, i = heapq.heappop(queue)
+        if done[j, i]:
+            continue
+        done[j, i] = True
+        for J, I in [(j, i + 1), (j, i - 1), (j + 1, i), (j - 1, i)]:
+            if 0 <= I < Mx and 0 <= J < My and not done[J, I]:
+                value = max(Z[J, I], w + epsilon)
+                if value < W[J, I]:
+                    W[J, I] = value
+                    heapq.heappush(queue, (value, J, I))
+
+    mask = PISM.Scalar(grid, "mask")
+    surface = PISM.Scalar1(grid, "surface")
+    with PISM.vec.Access([mask, surface]):
+        for i, j in grid.points():
+            mask[i, j] = M[j, i]
+            surface[i, j] = Z[j, i]
+
+    n_sweeps = PISM.fill_depressions(mask, epsilon, surface)
+
+    assert n_sweeps >= 2
+
+    with PISM.vec.Access(surface):
+        for i, j in grid.points():
+            np.testing.assert_almost_equal(surface[i, j], W[j, i])
+            assert surface[i, j] >= Z[j, i]
+
+def dimension_type_cache_test():
+    "Test that cached dimension types are updated when attributes change"
+    output_file = filename("dimension_type")
+    try:
+        f = PISM.File(ctx.com, output_file, PISM.PISM_NETCDF3, PISM.PISM_READWRITE_MOVE)
+        f.define_dimension("dim", 2)
+        f.define_variable("dim", PISM.PISM_DOUBLE, ["dim"])
+        f.write_attribute("dim", "units", "m")
+
+        system = ctx.unit_system
+        assert f.dimension_type("dim", system) == PISM.UNKNOWN_AXIS
+
+        f.write_attribute("dim", "axis", "X")
+        assert f.dimension_type("dim", system) == PISM.X_AXIS
+
+        f.write_attribute("dim", "axis", "Y")
+        assert f.dimension_type("dim", system) == PISM.Y_AXIS
+
+        f.write_attribute("dim", "units", "days")
+        assert f.dimension_type("dim", system) == PISM.T_AXIS
+
+        f.write_attribute("dim", "units", "m")
+        f.remove_attribute("dim", "axis")
+        assert f.dimension_type("dim", system) == PISM.UNKNOWN_AXIS
+
+        f.close()
+    finally:
+        os.remove(output_file)
+
+def chunk_dimensions_test():
+    "io::chunk_dimensions(): alignment with sub-domains and the chunk size limit"
+    MiB = 1024 * 1024
+
+    def check_alignment(procs, chunk):
+        start = 0
+        for w in procs:
+            assert start % chunk == 0
+            start += w
+
+    # even split: one chunk per sub-domain
+    c = PISM.chunk_dimensions("decomposition", [50, 50], [25, 25, 25, 25],
+                              True, 100, 100, 0, 8, 1024 * MiB)
+    assert list(c) == [1, 25, 50]
+
+    # chunks are aligned with sub-domains if widths have a useful common divisor
+    procs_x = [40, 20, 40]
+    c = PISM.chunk_dimensions("decomposition", procs_x, [100], False, 100, 100, 0, 8, 1024 * MiB)
+    check_alignment(procs_x, c[1])
+    assert list(c) == [100, 20]
+
+    # uneven split: use the widest sub-domain
+    c = PISM.chunk_dimensions("decomposition", [34, 33, 33], [100], False, 100, 100, 0, 8, 1024 * MiB)
+    assert list(c) == [100, 34]
+
+    # a 6000x6000x200 double field on one process (about 54 GiB) is split along z
+    for policy in ["decomposition", "field"]:
+        c = PISM.chunk_dimensions(policy, [6000], [6000], True, 6000, 6000, 200, 8, 1024 * MiB)
+        assert list(c)[:3] == [1, 6000, 6000]
+        assert 0 < c[3] < 200
+        assert np.prod(list(c)) * 8 <= 1024 * MiB
+
+    # a 2D layer that is too big is split along y, then x
+    c = PISM.chunk_dimensions("field", [6000], [6000], False, 6000, 6000, 200, 8, MiB)
+    assert c[2] == 1
+    assert np.prod(list(c)) * 8 <= MiB
+
+    c = PISM.chunk_dimensions("field", [6000], [6000], False, 6000, 6000, 0, 8, 8)
+    assert list(c) == [1, 1]
+
+def front_index_test():
+    "FrontIndex: incremental updates match a full rebuild"
+    grid = PISM.testing.shallow_grid(Mx=21, My=21)
+
+    mask = PISM.CellType1(grid, "cell_type")
+    front = PISM.FrontIndex(grid)
+
+    np.random.seed(1)
+    values = [PISM.MASK_ICE_FREE_BEDROCK, PISM.MASK_GROUNDED,
+              PISM.MASK_FLOATING, PISM.MASK_ICE_FREE_OCEAN]
+
+    def points(P):
+        return [(p.i, p.j) for p in P]
+
+    def expected():
+        "Lists of ice-free and icy cells near the margin, computed from scratch."
+        ice_free, icy = [], []
+        with PISM.vec.Access(nocomm=mask):
+            for (i, j) in grid.points():
+                if mask.ice_free(i, j) and mask.next_to_ice(i, j):
+                    ice_free.append((i, j))
+                if mask.ice_margin(i, j):
+                    icy.append((i, j))
+
+        # FrontIndex sorts points by j first, then by i
+        def order(p):
+            return (p[1], p[0])
+
+        return sorted(ice_free, key=order), sorted(icy, key=order)
+
+    def disk(R):
+        with PISM.vec.Access(nocomm=mask):
+            for (i, j) in grid.points():
+                if grid.x(i)**2 + grid.y(j)**2 < R**2:
+                    mask[i, j] = PISM.MASK_GROUNDED
+                else:
+                    mask[i, j] = PISM.MASK_ICE_FREE_OCEAN
+
+    def perturb():
+        with PISM.vec.Access(nocomm=mask):
+            for (i, j) in grid.points():
+                # np.random is called for every cell to get the same sequence of
+                # numbers regardless of the order of the checks below
+                change = np.random.rand() < 0.1
+                value = values[np.random.randint(len(values))]
+                if change:
+                    mask[i, j] = value
+
+    L = grid.Lx()
+    steps = [lambda: disk(0.5 * L),
+             perturb, perturb, perturb,
+             lambda: mask.set(PISM.MASK_GROUNDED),
+             lambda: disk(0.25 * L),
+             perturb, perturb]
+
+    for step in steps:
+        step()
+        mask.update_ghosts()
+
+        front.update(mask)
+
+        rebuilt = PISM.FrontIndex(grid)
+        rebuilt.update(mask)
+
+        ice_free, icy = expected()
+
+        # check that the test is not trivial (sub-domains may not contain the front if
+        # there are many of them)
+        if ctx.size == 1 and step != steps[4]:
+            assert len(ice_free) > 0 and len(icy) > 0
+
+        assert points(front.ice_free()) == points(rebuilt.ice_free())
+        assert points(front.icy()) == points(rebuilt.icy())
+
+        assert points(front.ice_free()) == ice_free
+        assert points(front.icy()) == icy
@@ -74,6 +74,18 @@ class SteadyHydrology(TestCase):
 
     def divergence_theorem_test(self):
         "Test that the total input equals the total flux through the boundary."
+        self.check_divergence_theorem()
+
+    def divergence_theorem_flow_accumulation_test(self):
+        "Test the divergence theorem using the flow accumulation method."
+        method = ctx.config.get_string("hydrology.steady.method")
+        try:
+            ctx.config.set_string("hydrology.steady.method", "flow_accumulation")
+            self.check_divergence_theorem()
+        finally:
+            ctx.config.set_string("hydrology.steady.method", method)
+
+    def check_divergence_theorem(self):
         grid = self.grid
 
         inputs = PISM.HydrologyInputs()
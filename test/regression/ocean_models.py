@@ -220,6 +220,58 @@ class GivenTHTest(TestCase):
 
         check_model(model, self.temperature, self.mass_flux, self.average_water_column_pressure)
 
+    def test_batch_update(self):
+        "GivenTH: batch_update() is equivalent to pointwise_update()"
+
+        def compare(constants, S, theta, H):
+            n = len(S)
+            batch = np.array(PISM.OceanGivenTH.batch_update_cells(constants, S, theta, H))
+            pointwise = np.array(PISM.OceanGivenTH.pointwise_update_cells(constants, S, theta, H))
+            np.testing.assert_allclose(batch, pointwise, rtol=1e-12, atol=0)
+            # shelf base melt rate
+            return batch[n:]
+
+        c = PISM.GivenTHConstants(config)
+        assert c.limit_salinity_range
+
+        # salinity (g/kg), potential temperature (Celsius) and ice thickness (meters)
+        melt      = [(35.0, 0.0, 500.0), (35.0, -1.9, 1000.0), (35.0, -1.5, 0.0)]
+        freeze_on = [(35.0, -3.0, 500.0), (35.0, -2.2, 10.0), (35.0, -2.5, 0.0)]
+        # sea water salinity outside of [4, 40] and basal salinity above 40 (the last one)
+        clipping  = [(2.0, 2.0, 100.0), (50.0, 0.0, 100.0), (35.0, -3.0, 0.0)]
+
+        cells = melt + freeze_on + clipping
+        S, theta, H = [list(x) for x in zip(*cells)]
+        M = compare(c, S, theta, H)
+        assert np.all(M[0:2] > 0) and np.all(M[3:5] < 0)
+        # no melt at ice-free cells
+        assert M[2] == 0 and M[5] == 0 and M[8] == 0
+
+        # more cells than batch_size: several batches and one partial batch
+        k = 2 * PISM.OceanGivenTH.batch_size // len(cells) + 1
+        compare(c, S * k, theta * k, H * k)
+
+        c.limit_salinity_range = False
+        cells = melt + freeze_on
+        S, theta, H = [list(x) for x in zip(*cells)]
+        compare(c, S, theta, H)
+
+        # with gamma_S = 0 neither the melt nor the freeze-on case is consistent, so the
+        # "diffusion-only" case is used
+        c.limit_salinity_range = True
+        c.gamma_S = 0.0
+        S, theta, H = [35.0, 35.0], [-2.0, -2.5], [500.0, 1000.0]
+        compare(c, S, theta, H)
+
+        # pointwise_update() is not defined at ice-free cells in this case, but
+        # batch_update() has to handle them (here: together with icy cells)
+        S, theta, H = S + [35.0], theta + [-2.0], H + [0.0]
+        batch = np.array(PISM.OceanGivenTH.batch_update_cells(c, S, theta, H))
+        pointwise = np.array(PISM.OceanGivenTH.pointwise_update_cells(c, S[:2], theta[:2], H[:2]))
+        assert np.all(np.isfinite(batch))
+        np.testing.assert_allclose(batch[[0, 1, 3, 4]], pointwise, rtol=1e-12, atol=0)
+        assert batch[5] == 0.0
+
     def tearDown(self):
         os.remove(self.filename)
 
@@ -558,6 +610,84 @@ class DeltaSL2D(TestCase):
     def tearDown(self):
         os.remove(self.filename)
 
+class PicoGeometryReuse(TestCase):
+    "PicoGeometry re-uses masks only if inputs did not change"
+
+    def setUp(self):
+        self.Mx = 41
+        self.grid = shallow_grid(Mx=self.Mx, My=11, Lx=200e3, Ly=50e3)
+        self.geometry = PISM.Geometry(self.grid)
+        self.filename = tmp_name("ocean_pico_geometry_input")
+
+        PISM.util.prepare_output(self.filename)
+        basins = PISM.Scalar(self.grid, "basins")
+        basins.set(1.0)
+        basins.write(self.filename)
+
+        config.set_string("ocean.pico.file", self.filename)
+
+        # grounded ice, an ice shelf and open ocean
+        self.set_geometry(shelf_end=28, ocean_bed=-1500.0)
+
+    def set_geometry(self, shelf_end, ocean_bed):
+        g = self.geometry
+        g.sea_level_elevation.set(0.0)
+        with PISM.vec.Access(nocomm=[g.ice_thickness, g.bed_elevation]):
+            for (i, j) in self.grid.points():
+                if i < 12:
+                    g.bed_elevation[i, j] = 100.0
+                    g.ice_thickness[i, j] = 1000.0
+                elif i < shelf_end:
+                    g.bed_elevation[i, j] = -1500.0
+                    g.ice_thickness[i, j] = 300.0
+                else:
+                    g.bed_elevation[i, j] = ocean_bed if i >= 30 else -1500.0
+                    g.ice_thickness[i, j] = 0.0
+        g.ensure_consistency(0.0)
+
+    def outputs(self, pico_geometry):
+        return [pico_geometry.box_mask().numpy(),
+                pico_geometry.ice_shelf_mask().numpy(),
+                pico_geometry.continental_shelf_mask().numpy(),
+                pico_geometry.ice_rise_mask().numpy()]
+
+    def fresh(self):
+        "Outputs of a PicoGeometry instance that has not seen earlier inputs"
+        pico_geometry = PISM.PicoGeometry(self.grid)
+        pico_geometry.init()
+        pico_geometry.update(self.geometry.bed_elevation, self.geometry.cell_type)
+        return self.outputs(pico_geometry)
+
+    def check(self, pico_geometry):
+        pico_geometry.update(self.geometry.bed_elevation, self.geometry.cell_type)
+        result = self.outputs(pico_geometry)
+        for a, b in zip(result, self.fresh()):
+            np.testing.assert_equal(a, b)
+        return result
+
+    def test_reuse(self):
+        "PicoGeometry: results match a fresh instance after re-using masks"
+        pico_geometry = PISM.PicoGeometry(self.grid)
+        pico_geometry.init()
+
+        first = self.check(pico_geometry)
+
+        # unchanged inputs: masks are re-used
+        self.check(pico_geometry)
+        self.check(pico_geometry)
+
+        # shallower bed in the open ocean: the continental shelf mask has to be updated
+        self.set_geometry(shelf_end=28, ocean_bed=-500.0)
+        bed_changed = self.check(pico_geometry)
+        assert np.any(bed_changed[2] != first[2])
+
+        # smaller ice shelf: all masks have to be updated
+        self.set_geometry(shelf_end=24, ocean_bed=-500.0)
+        cell_type_changed = self.check(pico_geometry)
+        assert np.any(cell_type_changed[1] != bed_changed[1])
+
+    def tearDown(self):
+        os.remove(self.filename)
 
 if __name__ == "__main__":
     PISM.Context().log.set_threshold(3)